@@ -35,6 +35,9 @@ class NOESISRUNTIME_API UNoesisFunctionLibrary : public UBlueprintFunctionLibrar
 	UFUNCTION(BlueprintCallable, Category = "NoesisGUI", meta = (HidePin = "Target"))
 	static void NotifyCanExecuteFunctionChanged(UObject* Owner, FName FunctionName);
 
+	UFUNCTION(BlueprintCallable, Category = "NoesisGUI")
+	static void FlushChangedNotifications();
+
 	UFUNCTION(BlueprintCallable, Category = "NoesisGUI", meta = (HidePin = "Target"))
 	static void TrySetDataContext(UObject* Element, UObject* DataContext);
 
@@ -136,6 +136,7 @@ class NOESISRUNTIME_API UNoesisInstance : public UUserWidget
 	bool IsGamepadSimulatedClick = false;
 	bool Is3DWidget = false;
 	mutable bool SupportsKeyboardFocus = true;
+	mutable bool RenderTreeDirty = true;
 
 	typedef TSharedPtr<class FNoesisSlateElement, ESPMode::ThreadSafe> FNoesisSlateElementPtr;
 	FNoesisSlateElementPtr NoesisSlateElement;
@@ -208,6 +209,7 @@ class NOESISRUNTIME_API UNoesisInstance : public UUserWidget
 	static UNoesisInstance* FromView(Noesis::IView* View);
 
 	void Update();
+	bool ConsumeRenderTreeDirty() const;
 
 	FVector2D GetSize() const;
 	void Init3DWidget(UWorld* World);
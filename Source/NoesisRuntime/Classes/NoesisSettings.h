@@ -89,6 +89,18 @@ class NOESISRUNTIME_API UNoesisSettings : public UObject
 	UPROPERTY(EditAnywhere, Config, Category = "XAML")
 	ENoesisFontStyle DefaultFontStyle;
 
+	/** Collects property changed notifications and raises each one once per frame, before views are updated */
+	UPROPERTY(EditAnywhere, Config, Category = "XAML")
+	bool DeferPropertyChangedNotifications = false;
+
+	/** View model classes whose reflection types are created at startup instead of the first time they are bound */
+	UPROPERTY(EditAnywhere, Config, Category = "XAML", meta = (ConfigRestartRequired = true))
+	TArray<TSoftClassPtr<UObject>> PreregisteredClasses;
+
+	/** Calls native getters, setters and commands of bound objects through their thunks instead of ProcessEvent */
+	UPROPERTY(EditAnywhere, Config, Category = "XAML")
+	bool CallNativeFunctionsDirectly = true;
+
 	/** Dimensions of texture used to cache glyphs */
 	UPROPERTY(EditAnywhere, Config, Category = "Rendering", meta = (ConfigRestartRequired = true))
 	ENoesisGlyphCacheDimensions GlyphTextureSize;
@@ -105,6 +117,14 @@ class NOESISRUNTIME_API UNoesisSettings : public UObject
 	UPROPERTY(EditAnywhere, Config, Category = "Rendering", meta = (ConfigRestartRequired = true, ClampMin = 0, UIMin = 0))
 	int32 OffscreenMaxSurfaces;
 
+	/** Number of released offscreen textures kept for reuse by new offscreen surfaces of the same size (0 = no pooling) */
+	UPROPERTY(EditAnywhere, Config, Category = "Rendering", meta = (ConfigRestartRequired = true, ClampMin = 0, UIMin = 0))
+	int32 OffscreenPoolSize = 8;
+
+	/** Number of released media players, with their textures and sound components, kept for reuse by new MediaElements (0 = no pooling) */
+	UPROPERTY(EditAnywhere, Config, Category = "Rendering", meta = (ClampMin = 0, UIMin = 0))
+	int32 MediaPlayerPoolSize = 4;
+
 	/** Width of offscreen textures (0 = automatic) */
 	UPROPERTY(EditAnywhere, Config, Category = "Rendering", meta = (ConfigRestartRequired = true, ClampMin = 0, UIMin = 0))
 	int32 OffscreenTextureWidth;
@@ -113,10 +133,34 @@ class NOESISRUNTIME_API UNoesisSettings : public UObject
 	UPROPERTY(EditAnywhere, Config, Category = "Rendering", meta = (ConfigRestartRequired = true, ClampMin = 0, UIMin = 0))
 	int32 OffscreenTextureHeight;
 
+	/** Skips render tree updates and offscreen rendering for views that didn't change since the last frame */
+	UPROPERTY(EditAnywhere, Config, Category = "Rendering")
+	bool SkipIdleViews = true;
+
+	/** Reuses pipeline states across batches and skips redundant pipeline changes between consecutive batches */
+	UPROPERTY(EditAnywhere, Config, Category = "Rendering", meta = (ConfigRestartRequired = true))
+	bool CachePipelineStates = true;
+
+	/** Number of frames of dynamic geometry kept alive in the streaming buffers before they are reused (0 = discard the buffers on every map) */
+	UPROPERTY(EditAnywhere, Config, Category = "Rendering", meta = (ConfigRestartRequired = true, ClampMin = 0, UIMin = 0, ClampMax = 8, UIMax = 8))
+	int32 DynamicBufferFramesInFlight = 3;
+
+	/** Size in KB of the vertex streaming buffer. It's never smaller than the size required by a single map */
+	UPROPERTY(EditAnywhere, Config, Category = "Rendering", meta = (ConfigRestartRequired = true, ClampMin = 0, UIMin = 0))
+	int32 DynamicVertexBufferSize = 2048;
+
+	/** Size in KB of the index streaming buffer. It's never smaller than the size required by a single map */
+	UPROPERTY(EditAnywhere, Config, Category = "Rendering", meta = (ConfigRestartRequired = true, ClampMin = 0, UIMin = 0))
+	int32 DynamicIndexBufferSize = 512;
+
 	/** Turning this setting on helps with TSR/TAA when rendering WorldUI */
 	UPROPERTY(EditAnywhere, Config, Category = "WorldUI", meta = (ConfigRestartRequired = true))
 	bool UpdateVelocities = true;
 
+	/** Camera movement, in world units, below which WorldUI elements are not sorted again unless they moved (0 = sort whenever the camera moves) */
+	UPROPERTY(EditAnywhere, Config, Category = "WorldUI", meta = (ClampMin = 0, UIMin = 0))
+	float WorldUISortThreshold = 0.0f;
+
 	/** Sets the logging level for general messages */
 	UPROPERTY(EditAnywhere, Config, Category = "Editor Settings")
 	ENoesisLoggingSettings GeneralLogLevel;
@@ -29,11 +29,16 @@ public:
 	void Remove3DElement();
 
 protected:
+	virtual void OnRegister() override;
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
-public:	
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+public:
+	/**
+	 * Updates culling and depth order of all the WorldUI components of a world. Called once per frame before the WorldUI view is updated.
+	 * Returns a sphere enclosing the visible components, empty if none is visible and with a negative radius if it can't be computed
+	 */
+	static FSphere UpdateWorldComponents(UWorld* World, const FMatrix* ViewProjectionMatrix, int32& NumVisibleComponents);
 
 	void OnTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
 
@@ -49,9 +54,31 @@ public:
 	UPROPERTY(EditAnywhere, Category = Noesis)
 	bool Center;
 
+	/** Maximum distance to the camera at which the element is shown (0 = no limit). Ignored with more than one local player */
+	UPROPERTY(EditAnywhere, Category = Noesis, meta = (ClampMin = 0, UIMin = 0))
+	float MaxDrawDistance = 0.0f;
+
+	/**
+	 * Removes the element from the WorldUI view while it is outside the camera frustum of the player, skipping its layout
+	 * and transform updates. Ignored with more than one local player. The element is hidden in every view, so leave it
+	 * disabled for scene captures
+	 */
+	UPROPERTY(EditAnywhere, Category = Noesis)
+	bool CullOutsideView = false;
+
 	UFUNCTION(BlueprintCallable, Category = "NoesisGUI")
 	void SetDataContext(UObject* DataContext);
 
 	Noesis::Ptr<Noesis::FrameworkElement> Element;
 	FDelegateHandle TransformUpdatedDelegateHandle;
+
+private:
+	bool UpdateCulling(const FVector* ViewLocation, const class FConvexVolume* ViewFrustum);
+	void SetCulled(bool InCulled);
+	void UpdateTransform();
+
+	bool Culled = false;
+	bool TransformDirty = false;
+	float BoundsRadius = 0.0f;
+	int32 ZIndex = INDEX_NONE;
 };
@@ -9,6 +9,9 @@
 #include "CoreMinimal.h"
 #include "Misc/EngineVersionComparison.h"
 
+// CoreUObject includes
+#include "UObject/SoftObjectPtr.h"
+
 // Noesis includes
 #include "NoesisSDK.h"
 
@@ -61,6 +64,10 @@ class NOESISRUNTIME_API UNoesisXaml : public UObject
 	void LoadComponent(Noesis::BaseComponent* Component);
 	uint32 GetContentHash() const;
 
+	// UObject interface
+	virtual void Serialize(FArchive& Ar) override;
+	// End of UObject interface
+
 #if WITH_EDITORONLY_DATA
 	UPROPERTY(VisibleAnywhere, Instanced, Category=ImportSettings)
 	TObjectPtr<class UAssetImportData> AssetImportData;
@@ -78,6 +85,9 @@ class NOESISRUNTIME_API UNoesisXaml : public UObject
 	void RegisterDependencies();
 	FString GetXamlUri() const;
 
+	/** Streams in the XAML and all its dependencies and registers them, so creating a view from it doesn't block in the providers */
+	static TSharedPtr<struct FStreamableHandle> PreloadXaml(const TSoftObjectPtr<UNoesisXaml>& Xaml, FSimpleDelegate OnPreloaded = FSimpleDelegate());
+
 #if WITH_EDITOR
 	void RenderThumbnail(FIntRect, const FTextureRHIRef&);
 	void DestroyThumbnailRenderData();
@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// NoesisGUI - http://www.noesisengine.com
+// Copyright (c) 2013 Noesis Technologies S.L. All Rights Reserved.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "LocCultureListener.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+LocCultureListener* LocCultureListener::sHead;
+LocCultureListener* LocCultureListener::sNextToNotify;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+LocCultureListener::LocCultureListener(): mPrev(nullptr), mNext(sHead)
+{
+    if (sHead != nullptr)
+    {
+        sHead->mPrev = this;
+    }
+    sHead = this;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+LocCultureListener::~LocCultureListener()
+{
+    if (sNextToNotify == this)
+    {
+        sNextToNotify = mNext;
+    }
+
+    if (mPrev != nullptr)
+    {
+        mPrev->mNext = mNext;
+    }
+    else
+    {
+        sHead = mNext;
+    }
+
+    if (mNext != nullptr)
+    {
+        mNext->mPrev = mPrev;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void LocCultureListener::NotifyCultureChanged()
+{
+    LocCultureListener* prevNextToNotify = sNextToNotify;
+
+    // Listeners created while notifying are linked at the head and don't need to be notified
+    LocCultureListener* listener = sHead;
+    while (listener != nullptr)
+    {
+        sNextToNotify = listener->mNext;
+        listener->OnCultureChanged();
+        listener = sNextToNotify;
+    }
+
+    sNextToNotify = prevNextToNotify;
+}
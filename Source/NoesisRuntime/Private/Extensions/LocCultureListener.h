@@ -0,0 +1,32 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// NoesisGUI - http://www.noesisengine.com
+// Copyright (c) 2013 Noesis Technologies S.L. All Rights Reserved.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Core includes
+#include "CoreMinimal.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Intrusive list of objects notified when the culture changes. Localized expressions link
+/// themselves here instead of each one binding a delegate to OnTextRevisionChangedEvent
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class LocCultureListener
+{
+public:
+    LocCultureListener();
+    virtual ~LocCultureListener();
+
+    virtual void OnCultureChanged() = 0;
+
+    /// Notifies all the registered listeners. Listeners can be destroyed while being notified
+    static void NotifyCultureChanged();
+
+private:
+    LocCultureListener* mPrev;
+    LocCultureListener* mNext;
+
+    static LocCultureListener* sHead;
+    static LocCultureListener* sNextToNotify;
+};
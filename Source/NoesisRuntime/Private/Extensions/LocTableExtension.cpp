@@ -5,6 +5,7 @@
 
 #include "Extensions/LocTableExtension.h"
 #include "NsGui/ContentPropertyMetaData.h"
+#include "LocCultureListener.h"
 
 // CoreUObject includes
 #include "Misc/PackageName.h"
@@ -46,7 +47,52 @@ static void DynamicConvert(const Noesis::Type* targetType, Noesis::Ptr<Noesis::B
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-class LocTableExpression : public Noesis::Expression
+static FName TableIdFromString(const char* id)
+{
+    FString idStr = StringCast<TCHAR>((UTF8CHAR*)id).Get();
+    FString PackageRoot, PackagePath, PackageName;
+    FPackageName::SplitLongPackageName(idStr, PackageRoot, PackagePath, PackageName, false);
+    if (FPackageName::IsValidTextForLongPackageName(idStr))
+    {
+        PackageName += TEXT(".") + PackageName;
+    }
+
+    return FName(PackageRoot + PackagePath + PackageName);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Expressions using the same table share one registry lookup until the text revision changes,
+// so a culture switch only finds each table once
+static FStringTableConstPtr FindLoadedStringTable(FName tableId)
+{
+    static TMap<FName, FStringTableConstPtr> LoadedTables;
+    static uint16 LoadedTablesRevision = 0;
+
+    uint16 TextRevision = FTextLocalizationManager::Get().GetTextRevision();
+    if (LoadedTablesRevision != TextRevision)
+    {
+        LoadedTables.Reset();
+        LoadedTablesRevision = TextRevision;
+    }
+
+    if (const FStringTableConstPtr* TablePtr = LoadedTables.Find(tableId))
+    {
+        return *TablePtr;
+    }
+
+    // We don't seem to need to call IStringTableEngineBridge::FullyLoadStringTableAsset(TableId);
+    FStringTableConstPtr TablePtr = FStringTableRegistry::Get().FindStringTable(tableId);
+    if (TablePtr && TablePtr->IsLoaded())
+    {
+        LoadedTables.Add(tableId, TablePtr);
+        return TablePtr;
+    }
+
+    return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class LocTableExpression : public Noesis::Expression, public LocCultureListener
 {
 public:
     LocTableExpression(LocTableExtension* extension, Noesis::DependencyObject* targetObject, const Noesis::DependencyProperty* targetProperty,
@@ -54,12 +100,6 @@ public:
         : mExtension(extension), mTargetObject(targetObject), mTargetProperty(targetProperty),
         mConverter(converter), mConverterParameter(converterParameter)
     {
-        CultureChangedHandle = FTextLocalizationManager::Get().OnTextRevisionChangedEvent.AddRaw(this, &LocTableExpression::OnCultureChanged);
-    }
-
-    ~LocTableExpression()
-    {
-        FTextLocalizationManager::Get().OnTextRevisionChangedEvent.Remove(CultureChangedHandle);
     }
 
     Noesis::Ptr<Noesis::BaseComponent> Evaluate() const
@@ -103,7 +143,7 @@ public:
     {
     }
 
-    void OnCultureChanged()
+    void OnCultureChanged() override
     {
         mTargetObject->InvalidateProperty(mTargetProperty);
     }
@@ -114,7 +154,6 @@ private:
     const Noesis::DependencyProperty* mTargetProperty;
     Noesis::Ptr<Noesis::IValueConverter> mConverter;
     Noesis::Ptr<BaseComponent> mConverterParameter;
-    FDelegateHandle CultureChangedHandle;
 
     NS_IMPLEMENT_INLINE_REFLECTION_(LocTableExpression, Noesis::Expression)
 };
@@ -188,18 +227,14 @@ FString LocTableExtension::GetDisplayString(Noesis::DependencyObject* object)
         id = object->GetValue<Noesis::String>(IdProperty).Str();
     }
 
-    FString idStr = StringCast<TCHAR>((UTF8CHAR*)id).Get();
-    FString PackageRoot, PackagePath, PackageName;
-    FPackageName::SplitLongPackageName(idStr, PackageRoot, PackagePath, PackageName, false);
-    if (FPackageName::IsValidTextForLongPackageName(idStr))
+    if (strcmp(mTableIdSource.Str(), id) != 0 || mTableId.IsNone())
     {
-        PackageName += TEXT(".") + PackageName;
+        mTableIdSource = id;
+        mTableId = TableIdFromString(id);
     }
 
-    FName TableId(PackageRoot + PackagePath + PackageName);
-    // We don't seem to need to call IStringTableEngineBridge::FullyLoadStringTableAsset(TableId);
-    auto TablePtr = FStringTableRegistry::Get().FindStringTable(TableId);
-    if (TablePtr && TablePtr->IsLoaded())
+    auto TablePtr = FindLoadedStringTable(mTableId);
+    if (TablePtr)
     {
         if (auto EntryPtr = TablePtr->FindEntry(StringCast<TCHAR>((UTF8CHAR*)GetKey()).Get()))
         {
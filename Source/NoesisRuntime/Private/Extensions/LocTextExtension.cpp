@@ -5,23 +5,18 @@
 
 #include "Extensions/LocTextExtension.h"
 #include "NsGui/ContentPropertyMetaData.h"
+#include "LocCultureListener.h"
 
 // Core includes
 #include "Misc/EngineVersionComparison.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-class LocTextExpression : public Noesis::Expression
+class LocTextExpression : public Noesis::Expression, public LocCultureListener
 {
 public:
     LocTextExpression(LocTextExtension* extension, Noesis::DependencyObject* targetObject, const Noesis::DependencyProperty* targetProperty)
         : mExtension(extension), mTargetObject(targetObject), mTargetProperty(targetProperty)
     {
-        CultureChangedHandle = FTextLocalizationManager::Get().OnTextRevisionChangedEvent.AddRaw(this, &LocTextExpression::OnCultureChanged);
-    }
-
-    ~LocTextExpression()
-    {
-        FTextLocalizationManager::Get().OnTextRevisionChangedEvent.Remove(CultureChangedHandle);
     }
 
     Noesis::Ptr<Noesis::BaseComponent> Evaluate() const
@@ -51,7 +46,7 @@ public:
     {
     }
 
-    void OnCultureChanged()
+    void OnCultureChanged() override
     {
         mTargetObject->InvalidateProperty(mTargetProperty);
     }
@@ -60,7 +55,6 @@ private:
     Noesis::Ptr<LocTextExtension> mExtension;
     Noesis::DependencyObject* mTargetObject;
     const Noesis::DependencyProperty* mTargetProperty;
-    FDelegateHandle CultureChangedHandle;
 
     NS_IMPLEMENT_INLINE_REFLECTION_(LocTextExpression, Noesis::Expression)
 };
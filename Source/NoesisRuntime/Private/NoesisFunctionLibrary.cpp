@@ -63,6 +63,11 @@ void UNoesisFunctionLibrary::NotifyCanExecuteFunctionChanged(UObject* Owner, FNa
 	NoesisNotifyCanExecuteFunctionChanged(Owner, FunctionName);
 }
 
+void UNoesisFunctionLibrary::FlushChangedNotifications()
+{
+	NoesisFlushPropertyChangedNotifications();
+}
+
 void UNoesisFunctionLibrary::TrySetDataContext(UObject* Element, UObject* DataContext)
 {
 	UNoesisBaseComponent* BaseComponent = Cast<UNoesisBaseComponent>(Element);
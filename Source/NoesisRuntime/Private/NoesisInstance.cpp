@@ -78,6 +78,7 @@
 #include "NoesisSupport.h"
 #include "Extensions/BackgroundImage.h"
 #include "NoesisSettings.h"
+#include "NoesisWorldUIComponent.h"
 
 #if WITH_COMMON_UI
 // CommonInput includes
@@ -108,6 +109,16 @@ DECLARE_CYCLE_STAT(TEXT("TouchMove"), STAT_NoesisInstance_OnTouchMoved, STATGROU
 DECLARE_CYCLE_STAT(TEXT("TouchUp"), STAT_NoesisInstance_OnTouchEnded, STATGROUP_Noesis);
 DECLARE_CYCLE_STAT(TEXT("MouseDoubleClick"), STAT_NoesisInstance_OnMouseButtonDoubleClick, STATGROUP_Noesis);
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Render Tree Updates"), STAT_NoesisInstance_RenderTreeUpdates, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Render Tree Updates Skipped"), STAT_NoesisInstance_RenderTreeUpdatesSkipped, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Slate Element Updates"), STAT_NoesisInstance_SlateElementUpdates, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Slate Element Update Batches"), STAT_NoesisInstance_SlateElementUpdateBatches, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Stale Slate Element Updates"), STAT_NoesisInstance_StaleSlateElementUpdates, STATGROUP_Noesis);
+
+DECLARE_CYCLE_STAT(TEXT("RenderWorldUIView"), STAT_NoesisInstance_RenderWorldUIView, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("WorldUI Elements Rendered"), STAT_NoesisInstance_WorldUIElementsRendered, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("WorldUI Elements Culled"), STAT_NoesisInstance_WorldUIElementsCulled, STATGROUP_Noesis);
+
 DECLARE_GPU_STAT_NAMED(NoesisOnscreen, TEXT("NoesisOnscreen"));
 DECLARE_GPU_STAT_NAMED(NoesisOffscreen, TEXT("NoesisOffscreen"));
 
@@ -175,7 +186,7 @@ public:
 #endif
 	// End of ICustomSlateElement interface
 
-	void UpdateRenderTree() const;
+	bool UpdateRenderTree() const;
 	void RenderOffscreen(FRHICommandList& RHICmdList) const;
 	void RenderOnscreen(FRHICommandList& RHICmdList, bool WithViewProj) const;
 
@@ -197,9 +208,12 @@ public:
 	Noesis::Matrix4 LeftEyeViewProj;
 	Noesis::Matrix4 RightEyeViewProj;
 	FMatrix ViewProjectionMatrix;
+	FSceneInterface* WorldUIScene = nullptr;
+	FSphere WorldUIBounds = FSphere(FVector::ZeroVector, -1.0f);
 	FNoesisRenderDevice* RenderDevice = nullptr;
 	float EngineGamma = 2.2f;
 	float SlateContrast = 1.0f;
+	bool PendingRenderTreeUpdate = false;
 };
 
 FNoesisSlateElement::FNoesisSlateElement(Noesis::Ptr<Noesis::IRenderer> InRenderer)
@@ -207,10 +221,149 @@ FNoesisSlateElement::FNoesisSlateElement(Noesis::Ptr<Noesis::IRenderer> InRender
 {
 }
 
+typedef TSharedPtr<FNoesisSlateElement, ESPMode::ThreadSafe> FNoesisSlateElementPtr;
+
+// Paints don't enqueue their own render command. Their updates are gathered here and applied by the
+// first Noesis element drawn in the frame, which renders the offscreen passes of all views back to back
+struct FNoesisSlateElementUpdate
+{
+	FNoesisSlateElementPtr NoesisSlateElement;
+	float EngineGamma;
+	float SlateContrast;
+	FSlateRect SlateRect;
+	FSlateRect CullingRect;
+	FSceneInterface* Scene;
+	FGameTime WorldTime;
+	uint64 FrameNumber;
+	bool UpdateRenderTree;
+};
+
+static FCriticalSection GSlateElementUpdatesLock;
+static TArray<FNoesisSlateElementUpdate> GSlateElementUpdates;
+
+static void QueueSlateElementUpdate(FNoesisSlateElementUpdate&& Update)
+{
+	FScopeLock Lock(&GSlateElementUpdatesLock);
+	GSlateElementUpdates.Add(MoveTemp(Update));
+}
+
+static void RemoveSlateElementUpdates(const FNoesisSlateElementPtr& NoesisSlateElement)
+{
+	FScopeLock Lock(&GSlateElementUpdatesLock);
+	GSlateElementUpdates.RemoveAll([&NoesisSlateElement](const FNoesisSlateElementUpdate& Update) { return Update.NoesisSlateElement == NoesisSlateElement; });
+}
+
+static TArray<FNoesisSlateElementPtr> ApplySlateElementUpdates()
+{
+	check(IsInRenderingThread());
+
+	TArray<FNoesisSlateElementUpdate> Updates;
+	{
+		FScopeLock Lock(&GSlateElementUpdatesLock);
+
+		// Updates are queued in frame order. Leave the ones painted for frames the render thread hasn't started yet
+		int32 NumUpdates = 0;
+		while (NumUpdates < GSlateElementUpdates.Num() && GSlateElementUpdates[NumUpdates].FrameNumber <= GFrameCounterRenderThread)
+		{
+			FNoesisSlateElementUpdate& Update = GSlateElementUpdates[NumUpdates];
+			if (Update.FrameNumber < GFrameCounterRenderThread)
+			{
+				// Painted in a frame where no Noesis element was drawn (e.g. the window was hidden or resized after
+				// painting). Its rect and scene are out of date, but the render tree change is kept for the next paint
+				INC_DWORD_STAT(STAT_NoesisInstance_StaleSlateElementUpdates);
+				Update.NoesisSlateElement->PendingRenderTreeUpdate |= Update.UpdateRenderTree;
+			}
+			else
+			{
+				Updates.Add(MoveTemp(Update));
+			}
+			++NumUpdates;
+		}
+		GSlateElementUpdates.RemoveAt(0, NumUpdates);
+	}
+
+	TArray<FNoesisSlateElementPtr> OffscreenElements;
+	if (Updates.Num() == 0)
+		return OffscreenElements;
+
+	TArray<FNoesisSlateElementPtr> RenderTreeElements;
+
+	INC_DWORD_STAT(STAT_NoesisInstance_SlateElementUpdateBatches);
+	INC_DWORD_STAT_BY(STAT_NoesisInstance_SlateElementUpdates, Updates.Num());
+
+	for (FNoesisSlateElementUpdate& Update : Updates)
+	{
+		FNoesisSlateElement* NoesisSlateElement = Update.NoesisSlateElement.Get();
+		NoesisSlateElement->EngineGamma = Update.EngineGamma;
+		NoesisSlateElement->SlateContrast = Update.SlateContrast;
+
+		NoesisSlateElement->Left = Update.SlateRect.Left;
+		NoesisSlateElement->Top = Update.SlateRect.Top;
+		NoesisSlateElement->Right = Update.SlateRect.Right;
+		NoesisSlateElement->Bottom = Update.SlateRect.Bottom;
+
+		NoesisSlateElement->CullingRect = Update.CullingRect;
+
+		NoesisSlateElement->Scene = Update.Scene;
+		NoesisSlateElement->IsMobileMultiView = false;
+		NoesisSlateElement->WorldTime = Update.WorldTime;
+		if (Update.UpdateRenderTree || NoesisSlateElement->PendingRenderTreeUpdate)
+		{
+			NoesisSlateElement->PendingRenderTreeUpdate = false;
+			RenderTreeElements.AddUnique(Update.NoesisSlateElement);
+		}
+	}
+
+	for (const FNoesisSlateElementPtr& NoesisSlateElement : RenderTreeElements)
+	{
+		if (NoesisSlateElement->UpdateRenderTree())
+		{
+			OffscreenElements.Add(NoesisSlateElement);
+		}
+	}
+
+	return OffscreenElements;
+}
+
+static void RenderOffscreen(FRHICommandList& RHICmdList, const TArray<FNoesisSlateElementPtr>& NoesisSlateElements)
+{
+	if (NoesisSlateElements.Num() == 0)
+		return;
+
+	// Make sure dynamic material cached uniform expressions are up to date before doing any rendering
+	FMaterialRenderProxy::UpdateDeferredCachedUniformExpressions();
+
+	SCOPE_CYCLE_COUNTER(STAT_NoesisInstance_DrawOffscreen);
+	SCOPED_DRAW_EVENT(RHICmdList, Noesis_Offscreen);
+	SCOPED_GPU_STAT(RHICmdList, NoesisOffscreen);
+
+	// Device state is only reset when switching between the gamma and linear devices
+	FNoesisRenderDevice* RenderDevice = nullptr;
+	for (const FNoesisSlateElementPtr& NoesisSlateElement : NoesisSlateElements)
+	{
+		if (NoesisSlateElement->RenderDevice != RenderDevice)
+		{
+			if (RenderDevice != nullptr)
+			{
+				RenderDevice->SetRHICmdList(nullptr);
+			}
+			RenderDevice = NoesisSlateElement->RenderDevice;
+			RenderDevice->SetRHICmdList(&RHICmdList);
+			RenderDevice->SetGammaAndContrast(2.2f, 1.0f);
+		}
+		RenderDevice->SetWorldTime(NoesisSlateElement->WorldTime);
+		RenderDevice->SetScene(NoesisSlateElement->Scene);
+		NoesisSlateElement->Renderer->RenderOffscreen();
+	}
+	RenderDevice->SetRHICmdList(nullptr);
+}
+
 #if UE_VERSION_OLDER_THAN(5, 5, 0)
 
 void FNoesisSlateElement::DrawRenderThread(FRHICommandListImmediate& RHICmdList, const void* InWindowBackBuffer)
 {
+	::RenderOffscreen(RHICmdList, ApplySlateElementUpdates());
+
 	ViewRect = GViewRect;
 	ViewProjectionMatrix = GViewProjectionMatrix;
 
@@ -265,6 +418,17 @@ void FNoesisSlateElement::DrawRenderThread(FRHICommandListImmediate& RHICmdList,
 
 void FNoesisSlateElement::Draw_RenderThread(FRDGBuilder& GraphBuilder, const FDrawPassInputs& Inputs)
 {
+	TArray<FNoesisSlateElementPtr> OffscreenElements = ApplySlateElementUpdates();
+	if (OffscreenElements.Num() > 0)
+	{
+		GraphBuilder.AddPass(RDG_EVENT_NAME("NoesisOffScreen"), ERDGPassFlags::NeverCull,
+			[OffscreenElements = MoveTemp(OffscreenElements)](FRHICommandListImmediate& RHICmdList)
+			{
+				::RenderOffscreen(RHICmdList, OffscreenElements);
+			}
+		);
+	}
+
 	const FRDGTextureDesc& ColorTargetDesc = Inputs.OutputTexture != nullptr ? Inputs.OutputTexture->Desc : FRDGTextureDesc();
 
 	ViewRect = GViewRect;
@@ -321,13 +485,14 @@ void FNoesisSlateElement::Draw_RenderThread(FRDGBuilder& GraphBuilder, const FDr
 
 #endif
 
-void FNoesisSlateElement::UpdateRenderTree() const
+bool FNoesisSlateElement::UpdateRenderTree() const
 {
 	if ((Renderer == nullptr) || (RenderDevice == nullptr))
-		return;
+		return false;
 
 	SCOPE_CYCLE_COUNTER(STAT_NoesisInstance_UpdateRenderTree);
-	Renderer->UpdateRenderTree();
+	INC_DWORD_STAT(STAT_NoesisInstance_RenderTreeUpdates);
+	return Renderer->UpdateRenderTree();
 }
 
 void FNoesisSlateElement::RenderOffscreen(FRHICommandList& RHICmdList) const
@@ -591,6 +756,10 @@ private:
 
 TMap<Noesis::IView*, UNoesisInstance*> ViewInstanceMap;
 
+// Live WorldUI instances, at most one per world. Input preprocessing and world lookups only care about these,
+// so they don't have to go through every view in ViewInstanceMap
+TArray<UNoesisInstance*, TInlineAllocator<4>> World3DInstances;
+
 UNoesisInstance* UNoesisInstance::FromView(Noesis::IView* View)
 {
 	UNoesisInstance** InstancePtr = ViewInstanceMap.Find(View);
@@ -639,10 +808,15 @@ void UNoesisInstance::InitInstance()
 		if (XamlView)
 		{
 			ViewInstanceMap.Add(XamlView.GetPtr(), this);
+			if (Is3DWidget)
+			{
+				World3DInstances.Add(this);
+			}
 
 			Noesis::Ptr<Noesis::IRenderer> Renderer(XamlView->GetRenderer());
 
 			NoesisSlateElement = MakeShared<FNoesisSlateElement, ESPMode::ThreadSafe>(Renderer);
+			RenderTreeDirty = true;
 
 			if (FApp::CanEverRender())
 			{
@@ -888,6 +1062,8 @@ void UNoesisInstance::Update()
 {
 	SCOPE_CYCLE_COUNTER(STAT_NoesisInstance_Update);
 
+	NoesisFlushPropertyChangedNotifications();
+
 	if (Xaml && XamlView)
 	{
 		XamlView->SetSize(Width, Height);
@@ -941,13 +1117,34 @@ void UNoesisInstance::Update()
 		{
 			Flags |= Noesis::RenderFlags_DepthTesting;
 		}
+		if (Flags != XamlView->GetFlags())
+		{
+			RenderTreeDirty = true;
+		}
 		XamlView->SetFlags(Flags);
 		XamlView->SetEmulateTouch(EmulateTouch);
-		XamlView->Update(CurrentTime);
+
+		// Changes are accumulated until the next paint consumes them
+		RenderTreeDirty |= XamlView->Update(CurrentTime);
 		UpdateWorldTime();
 	}
 }
 
+bool UNoesisInstance::ConsumeRenderTreeDirty() const
+{
+	// Views that didn't change since the last paint keep the render tree and offscreen textures
+	// from the previous frame, only the onscreen pass is replayed
+	bool Dirty = RenderTreeDirty || !GetDefault<UNoesisSettings>()->SkipIdleViews;
+	RenderTreeDirty = false;
+
+	if (!Dirty)
+	{
+		INC_DWORD_STAT(STAT_NoesisInstance_RenderTreeUpdatesSkipped);
+	}
+
+	return Dirty;
+}
+
 FVector2D UNoesisInstance::GetSize() const
 {
 	if (Xaml)
@@ -972,8 +1169,9 @@ void UNoesisInstance::Init3DWidget(UWorld* World)
 	{
 		ENQUEUE_RENDER_COMMAND(FNoesisInstance_Add3DSlateElement)
 		(
-			[NoesisSlateElement = NoesisSlateElement](FRHICommandListImmediate& RHICmdList)
+			[NoesisSlateElement = NoesisSlateElement, WorldUIScene = World->Scene](FRHICommandListImmediate& RHICmdList)
 			{
+				NoesisSlateElement->WorldUIScene = WorldUIScene;
 				GNoesis3DSlateElements.AddUnique(NoesisSlateElement.Get());
 			}
 		);
@@ -1015,6 +1213,9 @@ void UNoesisInstance::Tick3DWidget(UWorld* World, ELevelTick TickType, float Del
 
 	if (XamlView != nullptr)
 	{
+		FMatrix CullingViewProjection;
+		bool HasCullingViewProjection = false;
+
 		APlayerController* PlayerController = GetOwningPlayer();
 		if (PlayerController)
 		{
@@ -1067,6 +1268,9 @@ void UNoesisInstance::Tick3DWidget(UWorld* World, ELevelTick TickType, float Del
 							}
 						);
 						XamlView->SetProjectionMatrix(ViewProj);
+
+						CullingViewProjection = ViewProjForCulling;
+						HasCullingViewProjection = true;
 					}
 					else
 					{
@@ -1085,25 +1289,43 @@ void UNoesisInstance::Tick3DWidget(UWorld* World, ELevelTick TickType, float Del
 							}
 						);
 						XamlView->SetProjectionMatrix(ViewProj);
+
+						CullingViewProjection = ViewProjectionData.ComputeViewProjectionMatrix();
+						HasCullingViewProjection = true;
 					}
 				}
 			}
 		}
 
+		int32 NumVisibleComponents = 0;
+		FSphere WorldUIBounds = UNoesisWorldUIComponent::UpdateWorldComponents(World, HasCullingViewProjection ? &CullingViewProjection : nullptr, NumVisibleComponents);
+
+		// The bounds only enclose elements owned by WorldUI components. Elements added to the view directly
+		// can be anywhere, so views are only culled by the bounds when there are none of those
+		auto Panel = Xaml->FindName<Noesis::Panel>("Root");
+		if (Panel == nullptr || Panel->GetChildren()->Count() != NumVisibleComponents)
+		{
+			WorldUIBounds = FSphere(FVector::ZeroVector, -1.0f);
+		}
+
 		Update();
 
 		ENQUEUE_RENDER_COMMAND(FNoesisInstance_Tick3DWidget_UpdateSlateElement)
 		(
-			[NoesisSlateElement = NoesisSlateElement, Scene = Scene, WorldTime = WorldTime, Left = Left, Top = Top, Right = Left + Width, Bottom = Top + Height](FRHICommandListImmediate& RHICmdList)
+			[NoesisSlateElement = NoesisSlateElement, Scene = Scene, WorldTime = WorldTime, Left = Left, Top = Top, Right = Left + Width, Bottom = Top + Height,
+			UpdateRenderTree = ConsumeRenderTreeDirty(), WorldUIBounds](FRHICommandListImmediate& RHICmdList)
 			{
+				NoesisSlateElement->WorldUIBounds = WorldUIBounds;
 				NoesisSlateElement->Left = Left;
 				NoesisSlateElement->Top = Top;
 				NoesisSlateElement->Right = Right;
 				NoesisSlateElement->Bottom = Bottom;
 				NoesisSlateElement->Scene = Scene;
 				NoesisSlateElement->WorldTime = WorldTime;
-				NoesisSlateElement->UpdateRenderTree();
-				NoesisSlateElement->RenderOffscreen(RHICmdList);
+				if (UpdateRenderTree && NoesisSlateElement->UpdateRenderTree())
+				{
+					NoesisSlateElement->RenderOffscreen(RHICmdList);
+				}
 			}
 		);
 	}
@@ -1122,10 +1344,9 @@ void UNoesisInstance::ViewportResized3DWidget()
 
 static UNoesisInstance* Find3DInstanceForWorld(UWorld* World)
 {
-	for (auto ViewInstancePair : ViewInstanceMap)
+	for (UNoesisInstance* NoesisInstance : World3DInstances)
 	{
-		UNoesisInstance* NoesisInstance = ViewInstancePair.Value;
-		if (NoesisInstance->Is3DWidget && NoesisInstance->GetWorld() == World)
+		if (NoesisInstance->GetWorld() == World)
 		{
 			return NoesisInstance;
 		}
@@ -1307,6 +1528,7 @@ void UNoesisInstance::TermInstance()
 
 		ViewInstanceMap.Remove(XamlView.GetPtr());
 		ViewInstanceMap.Shrink();
+		World3DInstances.Remove(this);
 
 		Noesis::Ptr<Noesis::IRenderer> Renderer(XamlView->GetRenderer());
 		Xaml.Reset();
@@ -1317,6 +1539,7 @@ void UNoesisInstance::TermInstance()
 		(
 			[Renderer, Is3DWidget = Is3DWidget, NoesisSlateElement = MoveTemp(NoesisSlateElement)](FRHICommandListImmediate& RHICmdList) mutable
 			{
+				RemoveSlateElementUpdates(NoesisSlateElement);
 				NoesisSlateElement.Reset();
 
 				if (!Is3DWidget)
@@ -1578,29 +1801,17 @@ int32 UNoesisInstance::NativePaint(const FPaintArgs& Args, const FGeometry& Allo
 
 	if (XamlView != nullptr)
 	{
-		ENQUEUE_RENDER_COMMAND(FNoesisInstance_NativePaint_UpdateSlateElement)
-		(
-			[NoesisSlateElement = NoesisSlateElement, EngineGamma = GEngine ? GEngine->GetDisplayGamma() : 2.2f, SlateContrast = GSlateContrast,
-			SlateRect = AllottedGeometry.GetLayoutBoundingRect().Round(),
-			Scene = Scene, WorldTime = WorldTime, CullingRect = MyCullingRect.Round()](FRHICommandListImmediate& RHICmdList)
-			{
-				NoesisSlateElement->EngineGamma = EngineGamma;
-				NoesisSlateElement->SlateContrast = SlateContrast;
-
-				NoesisSlateElement->Left = SlateRect.Left;
-				NoesisSlateElement->Top = SlateRect.Top;
-				NoesisSlateElement->Right = SlateRect.Right;
-				NoesisSlateElement->Bottom = SlateRect.Bottom;
-
-				NoesisSlateElement->CullingRect = CullingRect;
-
-				NoesisSlateElement->Scene = Scene;
-				NoesisSlateElement->IsMobileMultiView = false;
-				NoesisSlateElement->WorldTime = WorldTime;
-				NoesisSlateElement->UpdateRenderTree();
-				NoesisSlateElement->RenderOffscreen(RHICmdList);
-			}
-		);
+		FNoesisSlateElementUpdate Update;
+		Update.NoesisSlateElement = NoesisSlateElement;
+		Update.EngineGamma = GEngine ? GEngine->GetDisplayGamma() : 2.2f;
+		Update.SlateContrast = GSlateContrast;
+		Update.SlateRect = AllottedGeometry.GetLayoutBoundingRect().Round();
+		Update.CullingRect = MyCullingRect.Round();
+		Update.Scene = Scene;
+		Update.WorldTime = WorldTime;
+		Update.FrameNumber = GFrameCounter;
+		Update.UpdateRenderTree = ConsumeRenderTreeDirty();
+		QueueSlateElementUpdate(MoveTemp(Update));
 
 		FSlateDrawElement::MakeCustom(OutDrawElements, LayerId, NoesisSlateElement);
 
@@ -2233,17 +2444,62 @@ static bool Render3DPostOpaque(const FRendererInfo& RendererInfo)
 	return !RendererInfo.IsMobileShadingPath || RendererInfo.IsMobileDeferredShadingPath;
 }
 
-static void AddWorldUIRenderPass(FRDGBuilder& GraphBuilder, FRDGTexture* ColorTexture, FRDGTexture* DepthStencilTexture, const FViewInfo& View, bool AlphaMask)
+typedef TArray<FNoesisSlateElement*, TInlineAllocator<4>> FNoesisWorldUIElements;
+
+static bool IsWorldUIVisibleInView(const FNoesisSlateElement* NoesisSlateElement, const FViewInfo& View)
+{
+	// Elements are only drawn into views of their own world
+	if (NoesisSlateElement->WorldUIScene != nullptr && NoesisSlateElement->WorldUIScene != View.Family->Scene)
+		return false;
+
+	// Negative radius means the bounds of the visible elements aren't known
+	const FSphere& Bounds = NoesisSlateElement->WorldUIBounds;
+	if (Bounds.W < 0.0f)
+		return true;
+
+	if (Bounds.W == 0.0f)
+		return false;
+
+	if (View.ViewFrustum.IntersectSphere(Bounds.Center, Bounds.W))
+		return true;
+
+	// Instanced stereo and multi-view render both eyes from the primary view
+	const FSceneView* InstancedView = (View.bIsInstancedStereoEnabled || View.bIsMobileMultiViewEnabled) ? View.GetInstancedSceneView() : nullptr;
+	return InstancedView != nullptr && InstancedView != &View && InstancedView->ViewFrustum.IntersectSphere(Bounds.Center, Bounds.W);
+}
+
+static FNoesisWorldUIElements GetWorldUIElementsForView(const FViewInfo& View)
+{
+	FNoesisWorldUIElements Elements;
+	for (auto NoesisSlateElement : GNoesis3DSlateElements)
+	{
+		if (IsWorldUIVisibleInView(NoesisSlateElement, View))
+		{
+			Elements.Add(NoesisSlateElement);
+		}
+		else
+		{
+			INC_DWORD_STAT(STAT_NoesisInstance_WorldUIElementsCulled);
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_NoesisInstance_WorldUIElementsRendered, Elements.Num());
+	return Elements;
+}
+
+static void AddWorldUIRenderPass(FRDGBuilder& GraphBuilder, FRDGTexture* ColorTexture, FRDGTexture* DepthStencilTexture, const FViewInfo& View, const FNoesisWorldUIElements& Elements, bool AlphaMask)
 {
 	FRenderTargetParameters* PassParameters = GraphBuilder.AllocParameters<FRenderTargetParameters>();
 	{
 		PassParameters->RenderTargets[0] = FRenderTargetBinding(ColorTexture, ERenderTargetLoadAction::ELoad);
 		PassParameters->RenderTargets.DepthStencil = FDepthStencilBinding(DepthStencilTexture, ERenderTargetLoadAction::ELoad, ERenderTargetLoadAction::EClear, AlphaMask ? FExclusiveDepthStencil::DepthWrite_StencilWrite : FExclusiveDepthStencil::DepthRead_StencilWrite);
 	}
-	GraphBuilder.AddPass(RDG_EVENT_NAME("NoesisTranslucentPass"), PassParameters, ERDGPassFlags::Raster | ERDGPassFlags::NeverCull,
-		[&View, AlphaMask](FRHICommandListImmediate& RHICmdList)
+	int32 ViewIndex = View.Family->Views.IndexOfByKey(&View);
+	GraphBuilder.AddPass(RDG_EVENT_NAME("NoesisTranslucentPass (View %d)", ViewIndex), PassParameters, ERDGPassFlags::Raster | ERDGPassFlags::NeverCull,
+		[&View, Elements, AlphaMask](FRHICommandListImmediate& RHICmdList)
 		{
-			for (auto NoesisSlateElement : GNoesis3DSlateElements)
+			SCOPE_CYCLE_COUNTER(STAT_NoesisInstance_RenderWorldUIView);
+			for (auto NoesisSlateElement : Elements)
 			{
 				FNoesisRenderDevice* RenderDevice = NoesisSlateElement->RenderDevice;
 				RenderDevice->IsWorldUI = true;
@@ -2276,8 +2532,12 @@ void NoesisDrawRenderThreadOverlay(FPostOpaqueRenderParameters& Params)
 	if (ColorTexture == nullptr || DepthStencilTexture == nullptr)
 		return;
 
+	FNoesisWorldUIElements Elements = GetWorldUIElementsForView(View);
+	if (Elements.Num() == 0)
+		return;
+
 	auto& GraphBuilder = *Params.GraphBuilder;
-	AddWorldUIRenderPass(GraphBuilder, ColorTexture, DepthStencilTexture, View, false);
+	AddWorldUIRenderPass(GraphBuilder, ColorTexture, DepthStencilTexture, View, Elements, false);
 }
 
 FDelegateHandle NoesisRegisterOverlayRender()
@@ -2363,10 +2623,15 @@ public:
 		if (ColorTexture == nullptr || DepthStencilTexture == nullptr)
 			return;
 
-		AddWorldUIRenderPass(GraphBuilder, ColorTexture, DepthStencilTexture, View, false);
+		// Visibility is resolved once per view and shared by the color and velocity passes
+		FNoesisWorldUIElements Elements = GetWorldUIElementsForView(View);
+		if (Elements.Num() == 0)
+			return;
+
+		AddWorldUIRenderPass(GraphBuilder, ColorTexture, DepthStencilTexture, View, Elements, false);
 		if (UpdateVelocities)
 		{
-			AddWorldUIRenderPass(GraphBuilder, View.GetSceneTextures().Velocity, DepthStencilTexture, View, true);
+			AddWorldUIRenderPass(GraphBuilder, View.GetSceneTextures().Velocity, DepthStencilTexture, View, Elements, true);
 		}
 	}
 
@@ -2426,6 +2691,10 @@ public:
 		if (Render3DPostOpaque(RendererInfo))
 			return;
 
+		FNoesisWorldUIElements Elements = GetWorldUIElementsForView(*View);
+		if (Elements.Num() == 0)
+			return;
+
 		// We need to clear the stencil buffer, since we're in the SceneColor pass
 		const auto& ViewRect = View->ViewRect;
 		auto Left = ViewRect.Min.X;
@@ -2434,7 +2703,8 @@ public:
 		auto Bottom = ViewRect.Max.Y;
 		RHICmdList.SetViewport(Left, Top, 0.0f, Right, Bottom, 1.0f);
 		DrawClearQuad(RHICmdList, false, FLinearColor(), false, 0.f, true, 0);
-		for (auto NoesisSlateElement : GNoesis3DSlateElements)
+		SCOPE_CYCLE_COUNTER(STAT_NoesisInstance_RenderWorldUIView);
+		for (auto NoesisSlateElement : Elements)
 		{
 			NoesisSlateElement->RenderView(RHICmdList, View);
 		}
@@ -2517,13 +2787,9 @@ public:
 		{
 			auto MyGeometry = GameViewport->GetTickSpaceGeometry();
 
-			for (auto ViewInstancePair : ViewInstanceMap)
+			for (UNoesisInstance* NoesisInstance : World3DInstances)
 			{
-				UNoesisInstance* NoesisInstance = ViewInstancePair.Value;
-				if (NoesisInstance->Is3DWidget)
-				{
-					NoesisInstance->NativeOnMouseMove(MyGeometry, InPointerEvent);
-				}
+				NoesisInstance->NativeOnMouseMove(MyGeometry, InPointerEvent);
 			}
 		}
 		return false;
@@ -2536,13 +2802,9 @@ public:
 		{
 			auto MyGeometry = GameViewport->GetTickSpaceGeometry();
 			
-			for (auto ViewInstancePair : ViewInstanceMap)
+			for (UNoesisInstance* NoesisInstance : World3DInstances)
 			{
-				UNoesisInstance* NoesisInstance = ViewInstancePair.Value;
-				if (NoesisInstance->Is3DWidget)
-				{
-					NoesisInstance->NativeOnMouseButtonDown(MyGeometry, InPointerEvent);
-				}
+				NoesisInstance->NativeOnMouseButtonDown(MyGeometry, InPointerEvent);
 			}
 		}
 		return false;
@@ -2556,13 +2818,9 @@ public:
 			auto MyGeometry = GameViewport->GetTickSpaceGeometry();
 			
 			
-			for (auto ViewInstancePair : ViewInstanceMap)
+			for (UNoesisInstance* NoesisInstance : World3DInstances)
 			{
-				UNoesisInstance* NoesisInstance = ViewInstancePair.Value;
-				if (NoesisInstance->Is3DWidget)
-				{
-					NoesisInstance->NativeOnMouseButtonUp(MyGeometry, InPointerEvent);
-				}
+				NoesisInstance->NativeOnMouseButtonUp(MyGeometry, InPointerEvent);
 			}
 		}
 		return false;
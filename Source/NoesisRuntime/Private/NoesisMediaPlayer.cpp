@@ -12,12 +12,15 @@
 #include "Misc/CoreDelegates.h"
 
 // CoreUObject includes
+#include "Misc/PackageName.h"
 #include "UObject/Package.h"
 
 // Engine includes
 #include "AudioDevice.h"
 #include "AudioDeviceManager.h"
 #include "TextureResource.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 #include "Engine/Texture2D.h"
 #include "Engine/Engine.h"
 
@@ -32,6 +35,7 @@
 
 // NoesisRuntime includes
 #include "NoesisRuntimeModule.h"
+#include "NoesisSettings.h"
 #include "NoesisSupport.h"
 #include "Render/NoesisRenderDevice.h"
 
@@ -41,6 +45,103 @@
 #include "NsApp/MediaElement.h"
 
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Media Player Pool Hits"), STAT_NoesisMediaPlayerPoolHits, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Media Player Pool Misses"), STAT_NoesisMediaPlayerPoolMisses, STATGROUP_Noesis);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Media Players"), STAT_NoesisPooledMediaPlayers, STATGROUP_Noesis);
+DECLARE_MEMORY_STAT(TEXT("Media Player Pool Memory"), STAT_NoesisMediaPlayerPoolMemory, STATGROUP_Noesis);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Released media players are kept with their texture and sound component, so MediaElements that are
+// created and destroyed repeatedly, like video thumbnails in a scrolling list, don't allocate new ones.
+// When the pool is full the least recently released players are destroyed. Only used in the game thread
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class FNoesisMediaPlayerPool
+{
+public:
+	struct FEntry
+	{
+		UMediaPlayer* MediaPlayer;
+		UMediaTexture* MediaTexture;
+		UMediaSoundComponent* SoundComponent;
+		uint32 Size;
+	};
+
+	static FNoesisMediaPlayerPool& Get()
+	{
+		static FNoesisMediaPlayerPool Pool;
+		return Pool;
+	}
+
+	bool Acquire(FEntry& OutEntry)
+	{
+		check(IsInGameThread());
+
+		if (Entries.Num() == 0)
+		{
+			INC_DWORD_STAT(STAT_NoesisMediaPlayerPoolMisses);
+			return false;
+		}
+
+		// Most recently released first
+		OutEntry = Entries.Pop();
+		DEC_DWORD_STAT(STAT_NoesisPooledMediaPlayers);
+		DEC_MEMORY_STAT_BY(STAT_NoesisMediaPlayerPoolMemory, OutEntry.Size);
+		INC_DWORD_STAT(STAT_NoesisMediaPlayerPoolHits);
+		return true;
+	}
+
+	void Release(UMediaPlayer* MediaPlayer, UMediaTexture* MediaTexture, UMediaSoundComponent* SoundComponent)
+	{
+		check(IsInGameThread());
+
+		int32 MaxSize = GetDefault<UNoesisSettings>()->MediaPlayerPoolSize;
+		if (MaxSize <= 0)
+		{
+			Destroy({ MediaPlayer, MediaTexture, SoundComponent, 0 });
+			return;
+		}
+
+		while (Entries.Num() >= MaxSize)
+		{
+			Evict(0);
+		}
+
+		uint32 Size = (uint32)MediaTexture->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+		Entries.Add({ MediaPlayer, MediaTexture, SoundComponent, Size });
+		INC_DWORD_STAT(STAT_NoesisPooledMediaPlayers);
+		INC_MEMORY_STAT_BY(STAT_NoesisMediaPlayerPoolMemory, Size);
+	}
+
+	void Empty()
+	{
+		while (Entries.Num() > 0)
+		{
+			Evict(0);
+		}
+	}
+
+private:
+	static void Destroy(const FEntry& Entry)
+	{
+		Entry.MediaPlayer->RemoveFromRoot();
+		Entry.MediaTexture->RemoveFromRoot();
+		if (Entry.SoundComponent != nullptr)
+		{
+			Entry.SoundComponent->RemoveFromRoot();
+		}
+	}
+
+	void Evict(int32 Index)
+	{
+		DEC_DWORD_STAT(STAT_NoesisPooledMediaPlayers);
+		DEC_MEMORY_STAT_BY(STAT_NoesisMediaPlayerPoolMemory, Entries[Index].Size);
+		Destroy(Entries[Index]);
+		Entries.RemoveAt(Index);
+	}
+
+	TArray<FEntry> Entries; // Least recently released first
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 NoesisMediaPlayer::NoesisMediaPlayer(NoesisApp::MediaElement* Owner, const Noesis::Uri& Uri, void*):
@@ -48,71 +149,127 @@ NoesisMediaPlayer::NoesisMediaPlayer(NoesisApp::MediaElement* Owner, const Noesi
 	TextureSource(*new Noesis::TextureSource()), View(nullptr), Volume(0.5f), Position(0.0),
 	Opened(false), Ended(false), KeepPlaying(false), IsBuffering(false)
 {
-	MediaPlayer = NewObject<UMediaPlayer>(GetTransientPackage(), NAME_None, RF_Transient | RF_Public);
-	MediaPlayer->AddToRoot();
+	FNoesisMediaPlayerPool::FEntry PooledEntry;
+	if (FNoesisMediaPlayerPool::Get().Acquire(PooledEntry))
+	{
+		MediaPlayer = PooledEntry.MediaPlayer;
+		MediaTexture = PooledEntry.MediaTexture;
+		SoundComponent = PooledEntry.SoundComponent;
 
-	MediaTexture = NewObject<UMediaTexture>(GetTransientPackage(), NAME_None, RF_Transient | RF_Public);
-	MediaTexture->AutoClear = true;
-	MediaTexture->SetMediaPlayer(MediaPlayer);
-	MediaTexture->UpdateResource();
-	MediaTexture->AddToRoot();
+		// Recreate the texture resource so the previous video's last frame isn't shown again
+		MediaTexture->UpdateResource();
+	}
+	else
+	{
+		MediaPlayer = NewObject<UMediaPlayer>(GetTransientPackage(), NAME_None, RF_Transient | RF_Public);
+		MediaPlayer->AddToRoot();
+
+		MediaTexture = NewObject<UMediaTexture>(GetTransientPackage(), NAME_None, RF_Transient | RF_Public);
+		MediaTexture->AutoClear = true;
+		MediaTexture->SetMediaPlayer(MediaPlayer);
+		MediaTexture->UpdateResource();
+		MediaTexture->AddToRoot();
+	}
 
 	FAudioDeviceHandle AudioDevice = GEngine->GetActiveAudioDevice();
 	if (AudioDevice.IsValid())
 	{
-		SoundComponent = NewObject<UMediaSoundComponent>(GetTransientPackage(), NAME_None, RF_Transient | RF_Public);
-		SoundComponent->bIsUISound = false;
-		SoundComponent->bIsPreviewSound = false;
-		SoundComponent->SetMediaPlayer(MediaPlayer);
-		SoundComponent->CreateAudioComponent(); // Make sure it plays on the active AudioDevice
-		SoundComponent->GetAudioComponent()->AudioDeviceID = AudioDevice->DeviceID;
-		SoundComponent->Initialize();
-		SoundComponent->AddToRoot();
+		if (SoundComponent == nullptr)
+		{
+			SoundComponent = NewObject<UMediaSoundComponent>(GetTransientPackage(), NAME_None, RF_Transient | RF_Public);
+			SoundComponent->bIsUISound = false;
+			SoundComponent->bIsPreviewSound = false;
+			SoundComponent->SetMediaPlayer(MediaPlayer);
+			SoundComponent->CreateAudioComponent(); // Make sure it plays on the active AudioDevice
+			SoundComponent->GetAudioComponent()->AudioDeviceID = AudioDevice->DeviceID;
+			SoundComponent->Initialize();
+			SoundComponent->AddToRoot();
+		}
+		else
+		{
+			// The active AudioDevice may have changed since the sound component was pooled
+			SoundComponent->GetAudioComponent()->AudioDeviceID = AudioDevice->DeviceID;
+			SoundComponent->SetVolumeMultiplier(1.0f);
+		}
 	}
 
 	FString VideoPath = NsProviderUriToAssetPath(Uri);
-	UMediaSource* MediaSource = LoadObject<UMediaSource>(nullptr, *VideoPath, nullptr, LOAD_NoWarn);
-	if (MediaSource != nullptr && MediaPlayer->OpenSource(MediaSource))
+	FString Url = StringCast<TCHAR>((UTF8CHAR*)Uri.Str()).Get();
+	FSoftObjectPath SourcePath(VideoPath + TEXT(".") + FPackageName::GetShortName(VideoPath));
+
+	// Media sources already in memory are opened right away, the rest are streamed in without blocking the
+	// game thread. Uris that aren't assets are opened as files
+	UMediaSource* MediaSource = Cast<UMediaSource>(SourcePath.ResolveObject());
+	if (MediaSource == nullptr && SourcePath.IsValid() && FPackageName::IsValidLongPackageName(SourcePath.GetLongPackageName()) &&
+		FPackageName::DoesPackageExist(SourcePath.GetLongPackageName()))
 	{
-		MediaPlayer->OnMediaEvent().AddRaw(this, &NoesisMediaPlayer::OnMediaEvent);
+		static FStreamableManager NoesisStreamableManager;
+		FStreamableManager& StreamableManager = UAssetManager::IsInitialized() ? UAssetManager::GetStreamableManager() : NoesisStreamableManager;
 
-		View = Owner->GetView();
-		View->Rendering() += Noesis::MakeDelegate(this, &NoesisMediaPlayer::OnRendering);
+		SourceLoadHandle = StreamableManager.RequestAsyncLoad(SourcePath, FStreamableDelegate::CreateLambda([this, SourcePath, VideoPath, Url, InView = Owner->GetView()]()
+		{
+			SourceLoadHandle.Reset();
+			OpenSource(Cast<UMediaSource>(SourcePath.ResolveObject()), VideoPath, Url, InView);
+		}));
+		if (SourceLoadHandle.IsValid())
+			return;
 	}
-	else if (MediaPlayer->OpenFile(StringCast<TCHAR>((UTF8CHAR*)Uri.Str()).Get()))
-	{
-		MediaPlayer->OnMediaEvent().AddRaw(this, &NoesisMediaPlayer::OnMediaEvent);
 
-		View = Owner->GetView();
-		View->Rendering() += Noesis::MakeDelegate(this, &NoesisMediaPlayer::OnRendering);
-	}
-	else
-	{
-		NS_LOG("Failed to open MediaSource '%s'. Copy video files into 'Content/Movies' in your Unreal project", (ANSICHAR*)StringCast<UTF8CHAR>(*VideoPath).Get());
-	}
+	OpenSource(MediaSource, VideoPath, Url, Owner->GetView());
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 NoesisMediaPlayer::~NoesisMediaPlayer()
 {
+	if (SourceLoadHandle.IsValid())
+	{
+		SourceLoadHandle->CancelHandle();
+		SourceLoadHandle.Reset();
+	}
+
 	if (View != nullptr)
 	{
 		View->Rendering() -= Noesis::MakeDelegate(this, &NoesisMediaPlayer::OnRendering);
 	}
 
+	// The texture is reused by other players, so it can't stay referenced by this image source
+	TextureSource->SetTexture(nullptr);
+
 	MediaPlayer->OnMediaEvent().RemoveAll(this);
 	MediaPlayer->Close();
-	MediaPlayer->RemoveFromRoot();
-	MediaPlayer = nullptr;
-
-	MediaTexture->RemoveFromRoot();
-	MediaTexture = nullptr;
+	MediaPlayer->SetRate(1.0f);
+	MediaPlayer->SetLooping(false);
 
 	if (SoundComponent != nullptr)
 	{
 		SoundComponent->Stop();
-		SoundComponent->RemoveFromRoot();
-		SoundComponent = nullptr;
+	}
+
+	FNoesisMediaPlayerPool::Get().Release(MediaPlayer, MediaTexture, SoundComponent);
+	MediaPlayer = nullptr;
+	MediaTexture = nullptr;
+	SoundComponent = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void NoesisMediaPlayer::EmptyPool()
+{
+	FNoesisMediaPlayerPool::Get().Empty();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void NoesisMediaPlayer::OpenSource(UMediaSource* MediaSource, const FString& VideoPath, const FString& Url, Noesis::IView* InView)
+{
+	if ((MediaSource != nullptr && MediaPlayer->OpenSource(MediaSource)) || MediaPlayer->OpenFile(Url))
+	{
+		MediaPlayer->OnMediaEvent().AddRaw(this, &NoesisMediaPlayer::OnMediaEvent);
+
+		View = InView;
+		View->Rendering() += Noesis::MakeDelegate(this, &NoesisMediaPlayer::OnRendering);
+	}
+	else
+	{
+		NS_LOG("Failed to open MediaSource '%s'. Copy video files into 'Content/Movies' in your Unreal project", (ANSICHAR*)StringCast<UTF8CHAR>(*VideoPath).Get());
 	}
 }
 
@@ -243,11 +400,23 @@ Noesis::ImageSource* NoesisMediaPlayer::GetTextureSource() const
 	return TextureSource;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static bool MatchesVideoTrackDimensions(UMediaPlayer* MediaPlayer, UMediaTexture* MediaTexture)
+{
+	// Players that don't report the dimensions of the selected track are trusted
+	FIntPoint VideoDim = MediaPlayer->GetVideoTrackDimensions(INDEX_NONE, INDEX_NONE);
+	if (VideoDim.X <= 0 || VideoDim.Y <= 0)
+		return true;
+
+	return (int32)MediaTexture->GetWidth() == VideoDim.X && (int32)MediaTexture->GetHeight() == VideoDim.Y;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 void NoesisMediaPlayer::OnRendering(Noesis::IView*)
 {
-	// Raise MediaOpened when texture is correctly created
-	if (Opened && MediaTexture->GetWidth() > 2 && MediaTexture->GetHeight() > 2)
+	// Raise MediaOpened when texture is correctly created. A pooled texture keeps the dimensions of the
+	// previous video until the first frame of the new one is rendered, so they must match the video track
+	if (Opened && MediaTexture->GetWidth() > 2 && MediaTexture->GetHeight() > 2 && MatchesVideoTrackDimensions(MediaPlayer, MediaTexture))
 	{
 		TextureSource->SetTexture(FNoesisRenderDevice::CreateTexture(MediaTexture));
 
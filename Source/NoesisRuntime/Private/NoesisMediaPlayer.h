@@ -54,7 +54,11 @@ public:
 	void Stop() override;
 	Noesis::ImageSource* GetTextureSource() const override;
 
+	/// Destroys the players kept for reuse. Called before exit, while UObjects are still alive
+	static void EmptyPool();
+
 private:
+	void OpenSource(class UMediaSource* MediaSource, const FString& VideoPath, const FString& Url, Noesis::IView* InView);
 	void OnRendering(Noesis::IView* View);
 	void OnMediaEvent(EMediaEvent Event);
 
@@ -64,6 +68,7 @@ private:
 	class UMediaSoundComponent* SoundComponent;
 
 	Noesis::Ptr<Noesis::TextureSource> TextureSource;
+	TSharedPtr<struct FStreamableHandle> SourceLoadHandle;
 	Noesis::IView* View;
 	float Rate;
 	float Volume;
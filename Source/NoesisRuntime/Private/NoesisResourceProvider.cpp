@@ -21,6 +21,7 @@
 #include "Engine/FontFace.h"
 
 // NoesisRuntime includes
+#include "NoesisRuntimeModule.h"
 #include "NoesisXaml.h"
 #include "NoesisSupport.h"
 #include "NoesisRive.h"
@@ -44,6 +45,31 @@ static bool IsFontFileData(const TArray<uint8>& FontFaceDataArray)
 #endif
 #endif
 
+DECLARE_CYCLE_STAT(TEXT("Provider"), STAT_NoesisProvider, STATGROUP_Noesis);
+DECLARE_CYCLE_STAT(TEXT("Provider Blocking Load Time"), STAT_NoesisProvider_BlockingLoad, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Provider Blocking Loads"), STAT_NoesisProvider_BlockingLoads, STATGROUP_Noesis);
+
+template<class T>
+static T* LoadProviderObject(const FString& Path)
+{
+	// Assets referenced by an already loaded XAML are in memory. Objects whose package is still being
+	// loaded asynchronously aren't ready yet, LoadObject waits for them
+	FString ObjectPath = Path + TEXT(".") + FPackageName::GetShortName(Path);
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+	T* Object = FindObject<T>(nullptr, *ObjectPath);
+#else
+	T* Object = FindFirstObject<T>(*ObjectPath);
+#endif
+	if (Object != nullptr && !Object->HasAnyFlags(RF_NeedLoad | RF_NeedPostLoad))
+	{
+		return Object;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_NoesisProvider_BlockingLoad);
+	INC_DWORD_STAT(STAT_NoesisProvider_BlockingLoads);
+	return LoadObject<T>(nullptr, *Path, nullptr, LOAD_NoWarn);
+}
+
 static Noesis::Ptr<Noesis::Stream> LoadFont(const UFontFace* FontFace)
 {
 	class FontArrayMemoryStream : public Noesis::MemoryStream
@@ -107,8 +133,9 @@ void FNoesisXamlProvider::OnXamlChanged(UNoesisXaml* Xaml)
 
 Noesis::Ptr<Noesis::Stream> FNoesisXamlProvider::LoadXaml(const Noesis::Uri& Uri)
 {
+	SCOPE_CYCLE_COUNTER(STAT_NoesisProvider);
 	FString Path = NsProviderUriToAssetPath(Uri);
-	UObject* Asset = LoadObject<UObject>(nullptr, *Path, nullptr, LOAD_NoWarn);
+	UObject* Asset = LoadProviderObject<UObject>(Path);
 
 	UNoesisXaml* Xaml = Cast<UNoesisXaml>(Asset);
 	if (Xaml)
@@ -151,8 +178,9 @@ void FNoesisTextureProvider::OnTextureChanged(UTexture2D* Texture)
 
 Noesis::TextureInfo FNoesisTextureProvider::GetTextureInfo(const Noesis::Uri& Uri)
 {
+	SCOPE_CYCLE_COUNTER(STAT_NoesisProvider);
 	FString TexturePath = NsProviderUriToAssetPath(Uri);
-	UTexture2D* Texture = LoadObject<UTexture2D>(nullptr, *TexturePath, nullptr, LOAD_NoWarn);
+	UTexture2D* Texture = LoadProviderObject<UTexture2D>(TexturePath);
 
 	if (Texture)
 	{
@@ -235,8 +263,9 @@ Noesis::Ptr<Noesis::Stream> FNoesisFontProvider::OpenFont(const Noesis::Uri& InF
 	Uri += "/";
 	Uri += InFilename;
 
+	SCOPE_CYCLE_COUNTER(STAT_NoesisProvider);
 	FString FontPath = NsProviderUriToAssetPath(Uri.Str());
-	const UFontFace* FontFace = LoadObject<UFontFace>(nullptr, *FontPath, nullptr, LOAD_NoWarn);
+	const UFontFace* FontFace = LoadProviderObject<UFontFace>(FontPath);
 
 	if (FontFace != nullptr)
 	{
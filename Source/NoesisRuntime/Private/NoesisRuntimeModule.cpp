@@ -85,6 +85,7 @@ extern "C" void NsShutdownPackageAppRiveBase();
 extern "C" void NsShutdownPackageAppRive();
 
 void NoesisInitTypeTables();
+void NoesisPreregisterClasses();
 void NoesisGarbageCollected();
 void NoesisCultureChanged();
 void NoesisReflectionRegistryCallback(Noesis::Symbol TypeId);
@@ -540,6 +541,53 @@ void ShowPasswordBoxVirtualKeyboard(Noesis::PasswordBox* PasswordBox)
 	PasswordBoxVirtualKeyboardEntry = NewPasswordBoxVirtualKeyboardEntry;
 }
 
+DECLARE_CYCLE_STAT(TEXT("LoadSound"), STAT_NoesisLoadSound, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sound Cache Hits"), STAT_NoesisSoundCacheHits, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sound Cache Misses"), STAT_NoesisSoundCacheMisses, STATGROUP_Noesis);
+
+// Sounds played by the views, by asset path. Filled with the sound dependencies of the XAMLs as they are
+// loaded and with the sounds resolved on playback. Entries don't keep sounds alive, and the ones that were
+// collected or failed to load are removed after each garbage collection
+static TMap<FName, TWeakObjectPtr<USoundWave>> SoundCache;
+
+static void NoesisRegisterSound(USoundWave* Sound)
+{
+	if (Sound != nullptr)
+	{
+		SoundCache.Add(Sound->GetOutermost()->GetFName(), Sound);
+	}
+}
+
+static USoundWave* NoesisFindSound(const Noesis::Uri& Uri)
+{
+	FString SoundPath = NsProviderUriToAssetPath(Uri);
+	FName SoundName(*SoundPath);
+
+	TWeakObjectPtr<USoundWave>* CachedSound = SoundCache.Find(SoundName);
+	if (CachedSound != nullptr && (CachedSound->IsValid() || CachedSound->IsExplicitlyNull()))
+	{
+		INC_DWORD_STAT(STAT_NoesisSoundCacheHits);
+		return CachedSound->Get();
+	}
+
+	INC_DWORD_STAT(STAT_NoesisSoundCacheMisses);
+	SCOPE_CYCLE_COUNTER(STAT_NoesisLoadSound);
+	USoundWave* Sound = LoadObject<USoundWave>(nullptr, *SoundPath, nullptr, LOAD_NoWarn);
+	SoundCache.Add(SoundName, Sound);
+	return Sound;
+}
+
+static void NoesisSoundCacheGarbageCollected()
+{
+	for (auto It = SoundCache.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
 void NoesisPlaySoundCallback(void* UserData, const Noesis::Uri& Uri, float Volume)
 {
 	if (!GIsRunning)
@@ -562,8 +610,7 @@ void NoesisPlaySoundCallback(void* UserData, const Noesis::Uri& Uri, float Volum
 	}
 #endif
 
-	FString SoundPath = NsProviderUriToAssetPath(Uri);
-	USoundWave* Sound = LoadObject<USoundWave>(nullptr, *SoundPath, nullptr, LOAD_NoWarn);
+	USoundWave* Sound = NoesisFindSound(Uri);
 
 	if (!Sound)
 		return;
@@ -769,6 +816,7 @@ public:
 		Noesis::GUI::SetCursorCallback(nullptr, &NoesisUpdateCursorCallback);
 
 		PostGarbageCollectConditionalBeginDestroyDelegateHandle = FCoreUObjectDelegates::PostGarbageCollectConditionalBeginDestroy.AddStatic(NoesisGarbageCollected);
+		SoundCacheGarbageCollectedDelegateHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddStatic(NoesisSoundCacheGarbageCollected);
 
 		PostEngineInitDelegateHandle = FCoreDelegates::OnPostEngineInit.AddRaw(this, &FNoesisRuntimeModule::OnPostEngineInit);
 		EnginePreExitDelegateHandle = FCoreDelegates::OnEnginePreExit.AddRaw(this, &FNoesisRuntimeModule::OnEnginePreExit);
@@ -835,6 +883,8 @@ public:
 		Settings->SetFontFallbacks();
 		Settings->SetFontDefaultProperties();
 
+		NoesisPreregisterClasses();
+
 		// This check is not done inside SetLicense because that is also invoked when user is typing the license and would spam the console
 		if (Settings->LicenseName == "" || Settings->LicenseKey == "")
 		{
@@ -906,6 +956,8 @@ public:
 
 		NoesisUnregisterSceneViewExtension(ViewExtension);
 		ViewExtension.Reset();
+
+		NoesisMediaPlayer::EmptyPool();
 	}
 
 	virtual void ShutdownModule() override
@@ -926,6 +978,8 @@ public:
 		FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitDelegateHandle);
 
 		FCoreUObjectDelegates::PostGarbageCollectConditionalBeginDestroy.Remove(PostGarbageCollectConditionalBeginDestroyDelegateHandle);
+		FCoreUObjectDelegates::GetPostGarbageCollect().Remove(SoundCacheGarbageCollectedDelegateHandle);
+		SoundCache.Empty();
 
 		void NoesisDeleteMaps();
 		NoesisDeleteMaps();
@@ -961,6 +1015,11 @@ public:
 		NoesisFontProvider->RegisterFont(FontFace);
 	}
 
+	virtual void RegisterSound(class USoundWave* Sound) override
+	{
+		NoesisRegisterSound(Sound);
+	}
+
 	virtual void OnXamlChanged(class UNoesisXaml* Xaml) override
 	{
 		NoesisXamlProvider->OnXamlChanged(Xaml);
@@ -987,6 +1046,7 @@ public:
 	Noesis::Ptr<FNoesisTextureProvider> NoesisTextureProvider;
 	Noesis::Ptr<FNoesisFontProvider> NoesisFontProvider;
 	FDelegateHandle PostGarbageCollectConditionalBeginDestroyDelegateHandle;
+	FDelegateHandle SoundCacheGarbageCollectedDelegateHandle;
 	FDelegateHandle PostEngineInitDelegateHandle;
 	FDelegateHandle EnginePreExitDelegateHandle;
 	FDelegateHandle CultureChangedHandle;
@@ -7,6 +7,7 @@
 
 // Core includes
 #include "UObject/PropertyPortFlags.h"
+#include "Containers/LruCache.h"
 #include "Misc/EngineVersionComparison.h"
 
 // CoreUObject includes
@@ -14,7 +15,9 @@
 #include "UObject/UObjectIterator.h"
 #include "UObject/UObjectThreadContext.h"
 #include "UObject/FieldIterator.h"
+#include "UObject/GCObject.h"
 #include "UObject/Package.h"
+#include "UObject/Stack.h"
 #if UE_VERSION_OLDER_THAN(5, 5, 0)
 #else
 #include "StructUtils/UserDefinedStruct.h"
@@ -22,6 +25,7 @@
 
 // Engine includes
 #include "Engine/Texture2D.h"
+#include "GameFramework/Actor.h"
 #include "Engine/TextureRenderTarget2D.h"
 #include "Engine/Blueprint.h"
 #include "Engine/UserDefinedStruct.h"
@@ -54,6 +58,7 @@
 #include "AssetRegistry/IAssetRegistry.h"
 
 // NoesisRuntime includes
+#include "Extensions/LocCultureListener.h"
 #include "NoesisInstance.h"
 #include "NoesisSupport.h"
 #include "NoesisStructs.h"
@@ -63,6 +68,7 @@
 #include "NoesisXaml.h"
 #include "NoesisWorldUIComponent.h"
 #include "NoesisEnums.h"
+#include "NoesisSettings.h"
 
 // Noesis includes
 #include "NoesisSDK.h"
@@ -81,6 +87,17 @@ DECLARE_CYCLE_STAT(TEXT("NoesisGarbageCollected"), STAT_NoesisGarbageCollected,
 DECLARE_CYCLE_STAT(TEXT("NoesisNotifyMapPropertyAdd"), STAT_NoesisNotifyMapPropertyAdd, STATGROUP_Noesis);
 DECLARE_CYCLE_STAT(TEXT("NoesisNotifyMapPropertyChanged"), STAT_NoesisNotifyMapPropertyChanged, STATGROUP_Noesis);
 DECLARE_CYCLE_STAT(TEXT("NoesisNotifyMapPropertyRemove"), STAT_NoesisNotifyMapPropertyRemove, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Struct Wrapper Allocations"), STAT_NoesisStructWrapperAllocations, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Struct Wrapper Pool Hits"), STAT_NoesisStructWrapperPoolHits, STATGROUP_Noesis);
+DECLARE_CYCLE_STAT(TEXT("NoesisFlushPropertyChangedNotifications"), STAT_NoesisFlushPropertyChangedNotifications, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Property Changed Notifications Raised"), STAT_NoesisPropertyChangedNotificationsRaised, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Property Changed Notifications Coalesced"), STAT_NoesisPropertyChangedNotificationsCoalesced, STATGROUP_Noesis);
+DECLARE_CYCLE_STAT(TEXT("NoesisCreateTypeClassForUClass"), STAT_NoesisCreateTypeClassForUClass, STATGROUP_Noesis);
+DECLARE_CYCLE_STAT(TEXT("NoesisPreregisterClasses"), STAT_NoesisPreregisterClasses, STATGROUP_Noesis);
+DECLARE_CYCLE_STAT(TEXT("NoesisCultureChanged"), STAT_NoesisCultureChanged, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Class Types Created"), STAT_NoesisClassTypesCreated, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Direct Native Function Calls"), STAT_NoesisDirectNativeFunctionCalls, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("ProcessEvent Function Calls"), STAT_NoesisProcessEventFunctionCalls, STATGROUP_Noesis);
 
 Noesis::Ptr<Noesis::BaseComponent> NoesisCreateComponentForTArray(void*, FArrayProperty*);
 Noesis::Ptr<Noesis::BaseComponent> NoesisCreateComponentForTArrayStruct(void*, FArrayProperty*, void*);
@@ -1061,6 +1078,30 @@ TMap<UMaterialInterface*, class NoesisTypeClass*> MaterialMap;
 TArray<class Noesis::Type*> DeletedTypes;
 bool NoesisIsShuttingDown = false;
 
+// FName equality ignores case but Noesis symbols don't
+struct FNoesisSymbolMapKeyFuncs : TDefaultMapKeyFuncs<FName, Noesis::Symbol, false>
+{
+	static FORCEINLINE bool Matches(KeyInitType A, KeyInitType B)
+	{
+		return A.IsEqual(B, ENameCase::CaseSensitive);
+	}
+};
+
+static TMap<FName, Noesis::Symbol, FDefaultSetAllocator, FNoesisSymbolMapKeyFuncs> SymbolMap;
+
+// Interns the Noesis symbol for a property or function name so it isn't converted and hashed again every time
+static Noesis::Symbol NoesisSymbolForName(FName Name)
+{
+	if (Noesis::Symbol* SymbolPtr = SymbolMap.Find(Name))
+	{
+		return *SymbolPtr;
+	}
+
+	Noesis::Symbol Symbol((ANSICHAR*)StringCast<UTF8CHAR>(*Name.ToString()).Get());
+	SymbolMap.Add(Name, Symbol);
+	return Symbol;
+}
+
 class NoesisObjectWrapper;
 class NoesisStructWrapper;
 class NoesisEnumWrapper;
@@ -1304,6 +1345,52 @@ static void DestroyFunctionParams(UFunction* Function, void* Params)
 	}
 }
 
+// Native functions that aren't events or RPCs are invoked through their thunk the same way ProcessEvent does,
+// skipping its callspace, tracing and script bookkeeping. Actors keep using ProcessEvent because they override it
+static bool CanCallFunctionDirectly(UObject* Object, UFunction* Function)
+{
+	return Function->HasAnyFunctionFlags(FUNC_Native) &&
+		!Function->HasAnyFunctionFlags(FUNC_Net | FUNC_Event | FUNC_Delegate) &&
+		!Object->IsA<AActor>() &&
+		GetDefault<UNoesisSettings>()->CallNativeFunctionsDirectly;
+}
+
+static void CallFunction(UObject* Object, UFunction* Function, void* Params)
+{
+	if (!CanCallFunctionDirectly(Object, Function))
+	{
+		INC_DWORD_STAT(STAT_NoesisProcessEventFunctionCalls);
+		Object->ProcessEvent(Function, Params);
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_NoesisDirectNativeFunctionCalls);
+
+	FFrame Stack(Object, Function, Params, nullptr, Function->ChildProperties);
+
+	// Thunks read out parameters from the frame's out parameter list
+	if (Function->HasAnyFunctionFlags(FUNC_HasOutParms))
+	{
+		FOutParmRec** LastOut = &Stack.OutParms;
+		for (TFieldIterator<FProperty> It(Function); It && ((It->PropertyFlags & CPF_Parm) == CPF_Parm); ++It)
+		{
+			FProperty* Property = *It;
+			if (Property->HasAnyPropertyFlags(CPF_OutParm))
+			{
+				FOutParmRec* Out = (FOutParmRec*)FMemory_Alloca(sizeof(FOutParmRec));
+				Out->Property = Property;
+				Out->PropAddr = Property->ContainerPtrToValuePtr<uint8>(Params);
+				Out->NextOutParm = nullptr;
+				*LastOut = Out;
+				LastOut = &Out->NextOutParm;
+			}
+		}
+	}
+
+	uint8* ReturnValueAddress = Function->ReturnValueOffset != MAX_uint16 ? (uint8*)Params + Function->ReturnValueOffset : nullptr;
+	Function->Invoke(Object, Stack, ReturnValueAddress);
+}
+
 Noesis::Ptr<Noesis::BaseComponent> GetFunctionProperty(void* BasePointer, UFunction* Getter)
 {
 	UObject* Object = (UObject*)BasePointer;
@@ -1311,7 +1398,7 @@ Noesis::Ptr<Noesis::BaseComponent> GetFunctionProperty(void* BasePointer, UFunct
 	{
 		void* Params = FMemory_Alloca(Getter->GetStructureSize());
 		InitializeFunctionParams(Getter, Params);
-		Object->ProcessEvent(Getter, Params);
+		CallFunction(Object, Getter, Params);
 		FProperty* OutputProperty = (FProperty*)Getter->ChildProperties; 
 		Noesis::Ptr<Noesis::BaseComponent> Ret = GetPropertyByRef(Params, OutputProperty);
 		DestroyFunctionParams(Getter, Params);
@@ -1329,7 +1416,7 @@ bool SetFunctionProperty(void* BasePointer, UFunction* Setter, Noesis::BaseCompo
 		InitializeFunctionParams(Setter, Params);
 		FProperty* InputProperty = (FProperty*)Setter->ChildProperties;
 		SetPropertyByRef(Params, InputProperty, Value);
-		Object->ProcessEvent(Setter, Params);
+		CallFunction(Object, Setter, Params);
 		DestroyFunctionParams(Setter, Params);
 		return true;
 }
@@ -1432,7 +1519,7 @@ class NoesisArrayWrapper : public Noesis::BaseComponent, public Noesis::IList, p
 {
 public:
 	NoesisArrayWrapper(void* ArrayPtr, FArrayProperty* InArrayProperty)
-		: ArrayProperty(InArrayProperty), ArrayPointer(ArrayPtr), PreviousCount(INDEX_NONE)
+		: ItemCache(MaxCachedItems), ArrayProperty(InArrayProperty), ArrayPointer(ArrayPtr), PreviousCount(INDEX_NONE)
 	{
 		check(ArrayProperty->Inner->GetOffset_ForDebug() == 0);
 		ArrayMap.Add(ArrayPointer, this);
@@ -1523,6 +1610,33 @@ protected:
 		ArrayHelper.RemoveValues(Index);
 	}
 
+	// Items handed out to Noesis are cached, so virtualized lists don't box them again every time they are
+	// requested and change notifications pass the same instances the views hold. The least recently used
+	// items are evicted first, so the cache follows the range realized by the list while it scrolls
+	Noesis::Ptr<Noesis::BaseComponent> GetItem(uint32 Index) const
+	{
+#if WITH_EDITOR
+		if (ArrayProperty == nullptr)
+			return nullptr;
+#endif
+		if (const Noesis::Ptr<Noesis::BaseComponent>* ItemPtr = ItemCache.FindAndTouch(Index))
+		{
+			return *ItemPtr;
+		}
+
+		Noesis::Ptr<Noesis::BaseComponent> Item = NativeGet(Index);
+		ItemCache.Add(Index, Item);
+		return Item;
+	}
+
+public:
+	// Called by every mutation notification that can move items, and when the owner notifies the array or a
+	// struct containing it changed, since its elements may have been written without array notifications
+	void ResetItemCache() const
+	{
+		ItemCache.Empty(MaxCachedItems);
+	}
+
 public:
 	// IList interface
 	virtual int32 Count() const override
@@ -1532,7 +1646,7 @@ public:
 
 	virtual Noesis::Ptr<Noesis::BaseComponent> GetComponent(uint32 Index) const override
 	{
-		return NativeGet(Index);
+		return GetItem(Index);
 	}
 
 	virtual void SetComponent(uint32 Index, Noesis::BaseComponent* Item) override
@@ -1562,7 +1676,7 @@ public:
 	{
 		for (uint32 Index = 0; Index != Count(); ++Index)
 		{
-			Noesis::Ptr<Noesis::BaseComponent> ItemAtIndex = NativeGet(Index);
+			Noesis::Ptr<Noesis::BaseComponent> ItemAtIndex = GetItem(Index);
 			if (ItemAtIndex && ItemAtIndex->Equals(Item))
 			{
 				return Index;
@@ -1574,11 +1688,13 @@ public:
 	virtual void RemoveAt(uint32_t Index) override
 	{
 		NativeRemoveAt(Index);
+		ResetItemCache();
 	}
 
 	virtual void Clear() override
 	{
 		NativeClear();
+		ResetItemCache();
 	}
 	// End of IList interface
 
@@ -1595,7 +1711,13 @@ public:
 
 	void NotifyPostInsert(uint32 Index)
 	{
-		Noesis::Ptr<Noesis::BaseComponent> Item = NativeGet(Index);
+		// Only items after the insertion point move
+		if ((int32)Index + 1 < NativeSize())
+		{
+			ResetItemCache();
+		}
+		ItemCache.Remove(Index);
+		Noesis::Ptr<Noesis::BaseComponent> Item = GetItem(Index);
 
 		// Preserve this in case it is deleted in the event handler
 		LOCAL_PRESERVE(this);
@@ -1606,13 +1728,14 @@ public:
 	void NotifyPreSet(int32 Index)
 	{
 		check(ItemToDelete == nullptr);
-		ItemToDelete = NativeGet(Index);
+		ItemToDelete = GetItem(Index);
 	}
 
 	void NotifyPostSet(int32 Index)
 	{
 		check(ItemToDelete != nullptr);
-		Noesis::Ptr<Noesis::BaseComponent> NewItem = NativeGet(Index);
+		ItemCache.Remove(Index);
+		Noesis::Ptr<Noesis::BaseComponent> NewItem = GetItem(Index);
 
 		// Preserve this in case it is deleted in the event handler
 		LOCAL_PRESERVE(this);
@@ -1624,12 +1747,13 @@ public:
 	void NotifyPreRemoveAt(int32 Index)
 	{
 		check(ItemToDelete == nullptr);
-		ItemToDelete = NativeGet(Index);
+		ItemToDelete = GetItem(Index);
 	}
 
 	void NotifyPostRemoveAt(int32 Index)
 	{
 		check(ItemToDelete != nullptr);
+		ResetItemCache();
 		// Preserve this in case it is deleted in the event handler
 		LOCAL_PRESERVE(this);
 		Noesis::NotifyCollectionChangedEventArgs CollectionChangedArgs = { Noesis::NotifyCollectionChangedAction_Remove, Index, -1, ItemToDelete, nullptr };
@@ -1639,6 +1763,8 @@ public:
 
 	void NotifyPostReset()
 	{
+		ResetItemCache();
+
 		// Preserve this in case it is deleted in the event handler
 		LOCAL_PRESERVE(this);
 		Noesis::NotifyCollectionChangedEventArgs CollectionChangedArgs = { Noesis::NotifyCollectionChangedAction_Reset, -1, -1, nullptr, nullptr };
@@ -1655,9 +1781,22 @@ public:
 	{
 		check(PreviousCount != INDEX_NONE);
 		uint32 Count = NativeSize();
-		for (uint32 Index = PreviousCount; Index != Count; ++Index)
+		if ((int32)Count != PreviousCount)
+		{
+			ResetItemCache();
+		}
+
+		// Collection changed events carry a single item, so bulk appends are notified as a reset
+		if (Count - PreviousCount > MaxItemNotifications)
+		{
+			NotifyPostReset();
+		}
+		else
 		{
-			NotifyPostInsert(Index);
+			for (uint32 Index = PreviousCount; Index != Count; ++Index)
+			{
+				NotifyPostInsert(Index);
+			}
 		}
 		PreviousCount = INDEX_NONE;
 	}
@@ -1672,6 +1811,10 @@ public:
 private:
 	Noesis::NotifyCollectionChangedEventHandler CollectionChangedHandler;
 
+	static constexpr int32 MaxCachedItems = 256;
+	static constexpr uint32 MaxItemNotifications = 64;
+	mutable TLruCache<uint32, Noesis::Ptr<Noesis::BaseComponent>> ItemCache;
+
 public:
 	FArrayProperty* ArrayProperty;
 	void* ArrayPointer; 
@@ -1941,6 +2084,13 @@ public:
 	~NoesisTypeClass()
 	{
 		check(NoesisIsShuttingDown);
+
+		while (FreeStructData != nullptr)
+		{
+			FFreeStructData* Next = FreeStructData->Next;
+			FMemory::Free(FreeStructData);
+			FreeStructData = Next;
+		}
 	}
 
 	bool Equals(const Noesis::BaseObject* BaseObject) const override
@@ -1994,6 +2144,9 @@ public:
 		PropertyVector Events = mEvents;
 		mEvents.Clear();
 		const Noesis::TypeClass* Base = mBase;
+		FFreeStructData* FreeStructs = FreeStructData;
+		int32 NumFreeStructs = NumFreeStructData;
+		FreeStructData = nullptr;
 		NoesisIsShuttingDown = true;
 		this->~NoesisTypeClass();
 		NoesisIsShuttingDown = false;
@@ -2001,6 +2154,8 @@ public:
 		mEvents = Noesis::MoveArg(Events);
 		mProperties = Noesis::MoveArg(Properties);
 		mBase = Base;
+		FreeStructData = FreeStructs;
+		NumFreeStructData = NumFreeStructs;
 	}
 
 	void InvalidateProperties()
@@ -2096,7 +2251,58 @@ public:
 		Class->DestroyStruct(Dest);
 	}
 
+	void* AllocateStruct()
+	{
+		void* StructData = FreeStructData;
+		if (StructData != nullptr)
+		{
+			FreeStructData = FreeStructData->Next;
+			--NumFreeStructData;
+			INC_DWORD_STAT(STAT_NoesisStructWrapperPoolHits);
+		}
+		else
+		{
+			// Freed blocks store the free list link, so they need to be able to hold a pointer
+			int32 Size = FMath::Max(GetStructureSize(), (int32)sizeof(FFreeStructData));
+			int32 Alignment = FMath::Max(GetMinAlignment(), (int32)alignof(FFreeStructData));
+			StructData = FMemory::Malloc(Size, Alignment);
+			INC_DWORD_STAT(STAT_NoesisStructWrapperAllocations);
+		}
+
+		InitializeStruct(StructData);
+		return StructData;
+	}
+
+	void FreeStruct(void* StructData)
+	{
+		DestroyStruct(StructData);
+
+		if (NumFreeStructData < MaxFreeStructData)
+		{
+			FFreeStructData* FreeStruct = (FFreeStructData*)StructData;
+			FreeStruct->Next = FreeStructData;
+			FreeStructData = FreeStruct;
+			++NumFreeStructData;
+		}
+		else
+		{
+			FMemory::Free(StructData);
+		}
+	}
+
 	NS_IMPLEMENT_INLINE_REFLECTION_(NoesisTypeClass, Noesis::TypeClass)
+
+private:
+	// Storage of destroyed struct wrappers is recycled for the next wrapper of the same struct
+	struct FFreeStructData
+	{
+		FFreeStructData* Next;
+	};
+
+	static constexpr int32 MaxFreeStructData = 256;
+
+	FFreeStructData* FreeStructData = nullptr;
+	int32 NumFreeStructData = 0;
 };
 
 bool IsTypeRegistered(Noesis::Type* TypeClass)
@@ -2141,14 +2347,12 @@ public:
 	NoesisStructWrapper(NoesisTypeClass* InTypeClass) :
 		Noesis::BaseComponent(), TypeClass(InTypeClass)
 	{
-		StructData = FMemory::Malloc(TypeClass->GetStructureSize(), TypeClass->GetMinAlignment());
-		TypeClass->InitializeStruct(GetStructPtr());
+		StructData = TypeClass->AllocateStruct();
 	}
 
 	~NoesisStructWrapper()
 	{
-		TypeClass->DestroyStruct(GetStructPtr());
-		FMemory::Free(StructData);
+		TypeClass->FreeStruct(StructData);
 	}
 
 	virtual const Noesis::TypeClass* GetClassType() const override
@@ -2350,11 +2554,11 @@ public:
 		{
 			if (CanExecuteFunction->NumParms == 1)
 			{
-				// Preserve this in case it is deleted in ProcessEvent
+				// Preserve this in case it is deleted in the called function
 				LOCAL_PRESERVE(this);
 				void* Params = FMemory_Alloca(CanExecuteFunction->GetStructureSize());
 				InitializeFunctionParams(CanExecuteFunction, Params);
-				Object->ProcessEvent(CanExecuteFunction, Params);
+				CallFunction(Object, CanExecuteFunction, Params);
 				FBoolProperty* OutputProperty = (FBoolProperty*)(CanExecuteFunction->ChildProperties);
 				bool Ret = OutputProperty->GetPropertyValue(OutputProperty->ContainerPtrToValuePtr<bool>(Params));
 				DestroyFunctionParams(CanExecuteFunction, Params);
@@ -2362,14 +2566,14 @@ public:
 			}
 			else
 			{
-				// Preserve this in case it is deleted in ProcessEvent
+				// Preserve this in case it is deleted in the called function
 				LOCAL_PRESERVE(this);
 				check(CanExecuteFunction->NumParms == 2);
 				void* Params = FMemory_Alloca(CanExecuteFunction->GetStructureSize());
 				InitializeFunctionParams(CanExecuteFunction, Params);
 				FProperty* InputProperty = (FProperty*)CanExecuteFunction->ChildProperties;
 				SetPropertyByRef(Params, InputProperty, Param);
-				Object->ProcessEvent(CanExecuteFunction, Params);
+				CallFunction(Object, CanExecuteFunction, Params);
 				FBoolProperty* OutputProperty = (FBoolProperty*)(CanExecuteFunction->ChildProperties->Next);
 				bool Ret = OutputProperty->GetPropertyValue(OutputProperty->ContainerPtrToValuePtr<bool>(Params));
 				DestroyFunctionParams(CanExecuteFunction, Params);
@@ -2390,17 +2594,17 @@ public:
 		{
 			if (Function->NumParms == 0)
 			{
-				Object->ProcessEvent(Function, nullptr);
+				CallFunction(Object, Function, nullptr);
 			}
 			else
 			{
-				// Preserve this in case it is deleted in ProcessEvent
+				// Preserve this in case it is deleted in the called function
 				LOCAL_PRESERVE(this);
 				void* Params = FMemory_Alloca(Function->GetStructureSize());
 				InitializeFunctionParams(Function, Params);
 				FProperty* InputProperty = (FProperty*)Function->ChildProperties;
 				SetPropertyByRef(Params, InputProperty, Param);
-				Object->ProcessEvent(Function, Params);
+				CallFunction(Object, Function, Params);
 				DestroyFunctionParams(Function, Params);
 			}
 		}
@@ -2759,7 +2963,7 @@ DEFINE_FUNCTION(execNoesisDelegate)
 	if (Wrapper != nullptr)
 	{
 		auto TypeClass = (NoesisTypeClass*)Wrapper->GetClassType();
-		Noesis::TypeClassEvent ClassEvent = Noesis::FindEvent(TypeClass, Noesis::Symbol((ANSICHAR*)StringCast<UTF8CHAR>(*EventName).Get()));
+		Noesis::TypeClassEvent ClassEvent = Noesis::FindEvent(TypeClass, NoesisSymbolForName(FName(*EventName)));
 		auto TypeProperty = (NoesisTypePropertyObjectWrapperEvent*)ClassEvent.event;
 		if (TypeProperty != nullptr)
 		{
@@ -3008,7 +3212,7 @@ void NoesisFillTypeClassForUStruct(NoesisTypeClass* TypeClass, UScriptStruct* Cl
 			ensure(PropertyName.FindLastChar(TEXT('_'), UnderscorePosition));
 			PropertyName = PropertyName.LeftChop(PropertyName.Len() - UnderscorePosition);
 		}
-		Noesis::Symbol PropertyId = Noesis::Symbol((ANSICHAR*)StringCast<UTF8CHAR>(*PropertyName).Get());
+		Noesis::Symbol PropertyId = NoesisSymbolForName(FName(*PropertyName));
 
 		const Noesis::Type* PropertyType = GetPropertyType(Property);
 		if (PropertyType != nullptr)
@@ -3070,7 +3274,7 @@ void NoesisFillTypeClassForUClass(NoesisTypeClass* TypeClass, UClass* Class)
 
 			if (HasNoParams)
 			{
-				NoesisTypeProperty* TypeProperty = new NoesisTypePropertyObjectWrapperCommand(Noesis::Symbol((ANSICHAR*)StringCast<UTF8CHAR>(*Function->GetName()).Get()), Noesis::TypeOf<NoesisFunctionWrapper>(), Function, CanExecuteFunction);
+				NoesisTypeProperty* TypeProperty = new NoesisTypePropertyObjectWrapperCommand(NoesisSymbolForName(Function->GetFName()), Noesis::TypeOf<NoesisFunctionWrapper>(), Function, CanExecuteFunction);
 				TypeClass->AddProperty(TypeProperty);
 			}
 			else
@@ -3078,7 +3282,7 @@ void NoesisFillTypeClassForUClass(NoesisTypeClass* TypeClass, UClass* Class)
 				const Noesis::Type* ParamType = GetPropertyType(Param);
 				if (ParamType != nullptr)
 				{
-					NoesisTypeProperty* TypeProperty = new NoesisTypePropertyObjectWrapperCommand(Noesis::Symbol((ANSICHAR*)StringCast<UTF8CHAR>(*Function->GetName()).Get()), Noesis::TypeOf<NoesisFunctionWrapper>(), Function, CanExecuteFunction);
+					NoesisTypeProperty* TypeProperty = new NoesisTypePropertyObjectWrapperCommand(NoesisSymbolForName(Function->GetFName()), Noesis::TypeOf<NoesisFunctionWrapper>(), Function, CanExecuteFunction);
 					TypeClass->AddProperty(TypeProperty);
 				}
 			}
@@ -3091,7 +3295,7 @@ void NoesisFillTypeClassForUClass(NoesisTypeClass* TypeClass, UClass* Class)
 		{
 			IsGetter = true;
 			SetterName[0] = TEXT('S');
-			PropertyId = Noesis::Symbol((ANSICHAR*)StringCast<UTF8CHAR>(*FunctionName.RightChop(3)).Get());
+			PropertyId = NoesisSymbolForName(FName(*FunctionName.RightChop(3)));
 		}
 
 		if (IsGetter)
@@ -3135,8 +3339,7 @@ void NoesisFillTypeClassForUClass(NoesisTypeClass* TypeClass, UClass* Class)
 	for (TFieldIterator<FProperty> PropertyIt(Class, EFieldIteratorFlags::ExcludeSuper); PropertyIt; ++PropertyIt)
 	{
 		FProperty* Property = *PropertyIt;
-		FString PropertyName = Property->GetName();
-		Noesis::Symbol PropertyId = Noesis::Symbol((ANSICHAR*)StringCast<UTF8CHAR>(*PropertyName).Get());
+		Noesis::Symbol PropertyId = NoesisSymbolForName(Property->GetFName());
 
 		if (TypeClass->FindProperty(PropertyId) == nullptr)
 		{
@@ -3191,6 +3394,9 @@ Noesis::TypeClass* NoesisCreateTypeClassForUClass(UClass* Class)
 		return *TypeClassPtr;
 	}
 
+	SCOPE_CYCLE_COUNTER(STAT_NoesisCreateTypeClassForUClass);
+	INC_DWORD_STAT(STAT_NoesisClassTypesCreated);
+
 	FString RegisterClassName = RegisterNameFromPath(Class->GetPathName());
 	NoesisTypeClass* TypeClass = new NoesisTypeClass(Noesis::Symbol((ANSICHAR*)StringCast<UTF8CHAR>(*RegisterClassName).Get()));
 
@@ -3200,6 +3406,51 @@ Noesis::TypeClass* NoesisCreateTypeClassForUClass(UClass* Class)
 	return TypeClass;
 }
 
+// Keeps the preregistered classes alive so their types aren't destroyed by garbage collection
+class FNoesisPreregisteredClasses : public FGCObject
+{
+public:
+	TArray<TObjectPtr<UClass>> Classes;
+
+	// FGCObject interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+	{
+		Collector.AddReferencedObjects(Classes);
+	}
+
+	virtual FString GetReferencerName() const override
+	{
+		return TEXT("FNoesisPreregisteredClasses");
+	}
+	// End of FGCObject interface
+};
+
+static TUniquePtr<FNoesisPreregisteredClasses> PreregisteredClasses;
+
+void NoesisPreregisterClasses()
+{
+	SCOPE_CYCLE_COUNTER(STAT_NoesisPreregisterClasses);
+
+	for (const TSoftClassPtr<UObject>& ClassPtr : GetDefault<UNoesisSettings>()->PreregisteredClasses)
+	{
+		UClass* Class = ClassPtr.LoadSynchronous();
+		if (Class != nullptr)
+		{
+			if (!PreregisteredClasses.IsValid())
+			{
+				PreregisteredClasses = MakeUnique<FNoesisPreregisteredClasses>();
+			}
+			PreregisteredClasses->Classes.AddUnique(Class);
+
+			Noesis::TypeClass* Type = NoesisCreateTypeClassForUClass(Class);
+			if (!IsTypeRegistered(Type))
+			{
+				Noesis::Reflection::RegisterType(Type);
+			}
+		}
+	}
+}
+
 Noesis::BaseComponent* CallbackCreateMaterialWrapper(Noesis::Symbol Name)
 {
 	FString UnrealTypeName = StringCast<TCHAR>((UTF8CHAR*)Name.Str()).Get();
@@ -3614,7 +3865,7 @@ void NoesisDestroyTypeClassForStruct(UUserDefinedStruct* BaseStruct)
 							if (Object->GetClass() == OwnerClass)
 							{
 								NoesisObjectWrapper* Wrapper = (NoesisObjectWrapper*)ObjectComponentPair.Value;
-								auto PropertySymbol = Noesis::Symbol((ANSICHAR*)StringCast<UTF8CHAR>(*Field->GetName()).Get());
+								auto PropertySymbol = NoesisSymbolForName(Field->GetFName());
 								Wrapper->NotifyPropertyChanged(PropertySymbol);
 							}
 						}
@@ -3668,7 +3919,7 @@ void NoesisDestroyTypeClassForEnum(UEnum* Enum)
 							if (Object->GetClass() == OwnerClass)
 							{
 								NoesisObjectWrapper* Wrapper = (NoesisObjectWrapper*)ObjectComponentPair.Value;
-								auto PropertySymbol = Noesis::Symbol((ANSICHAR*)StringCast<UTF8CHAR>(*Field->GetName()).Get());
+								auto PropertySymbol = NoesisSymbolForName(Field->GetFName());
 								Wrapper->NotifyPropertyChanged(PropertySymbol);
 							}
 						}
@@ -3705,7 +3956,7 @@ void NoesisDestroyTypeClassForEnum(UEnum* Enum)
 							if (Object->GetClass() == OwnerClass)
 							{
 								NoesisObjectWrapper* Wrapper = (NoesisObjectWrapper*)ObjectComponentPair.Value;
-								auto PropertySymbol = Noesis::Symbol((ANSICHAR*)StringCast<UTF8CHAR>(*Field->GetName()).Get());
+								auto PropertySymbol = NoesisSymbolForName(Field->GetFName());
 								Wrapper->NotifyPropertyChanged(PropertySymbol);
 							}
 						}
@@ -3904,14 +4155,15 @@ NOESISRUNTIME_API UObject* NoesisFindUObjectForComponent(Noesis::BaseComponent*
 	if (Component == nullptr)
 		return nullptr;
 
+	// Wrappers keep their UObject until it's garbage collected, which is when they are removed from ObjectMap
 	NoesisObjectWrapper* Wrapper = Noesis::DynamicCast<NoesisObjectWrapper*>(Component);
-	if (Wrapper != nullptr)
+	if (Wrapper != nullptr && Wrapper->Object != nullptr)
 	{
-		UObject* const* ObjectPtr = ObjectMap.FindKey(Wrapper);
-		if (ObjectPtr)
-		{
-			return *ObjectPtr;
-		}
+		if (!IsValid(Wrapper->Object) || Wrapper->Object->IsUnreachable())
+			return nullptr;
+
+		check(ObjectMap.FindRef(Wrapper->Object) == Wrapper);
+		return Wrapper->Object;
 	}
 
 	return nullptr;
@@ -3919,7 +4171,8 @@ NOESISRUNTIME_API UObject* NoesisFindUObjectForComponent(Noesis::BaseComponent*
 
 NOESISRUNTIME_API Noesis::Ptr<Noesis::BaseComponent> NoesisCreateComponentForUObject(UObject* Object)
 {
-	if (!Object)
+	// Unreachable objects aren't wrapped, their wrappers would outlive the sweep after garbage collection
+	if (!Object || Object->IsUnreachable())
 	{
 		return nullptr;
 	}
@@ -4001,14 +4254,15 @@ NOESISRUNTIME_API UObject* NoesisCreateUObjectForComponent(Noesis::BaseComponent
 	if (Component == nullptr)
 		return nullptr;
 
+	// Wrappers keep their UObject until it's garbage collected, which is when they are removed from ObjectMap
 	NoesisObjectWrapper* Wrapper = Noesis::DynamicCast<NoesisObjectWrapper*>(Component);
-	if (Wrapper != nullptr)
+	if (Wrapper != nullptr && Wrapper->Object != nullptr)
 	{
-		UObject* const* ObjectPtr = ObjectMap.FindKey(Wrapper);
-		if (ObjectPtr)
-		{
-			return *ObjectPtr;
-		}
+		if (!IsValid(Wrapper->Object) || Wrapper->Object->IsUnreachable())
+			return nullptr;
+
+		check(ObjectMap.FindRef(Wrapper->Object) == Wrapper);
+		return Wrapper->Object;
 	}
 
 	UNoesisBaseComponent* BaseComponent = NewObject<UNoesisBaseComponent>();
@@ -4026,14 +4280,53 @@ NOESISRUNTIME_API void NoesisCopyUStructFromComponent(UScriptStruct* Struct, Noe
 	Struct->CopyScriptStruct(Dest, Wrapper->GetStructPtr(), 1);
 }
 
-void NoesisNotifyPropertyChanged(UObject* Owner, FName PropertyName)
+typedef TPair<TWeakObjectPtr<UObject>, FName> FNoesisDeferredNotification;
+
+// Deferred notifications are raised in the order they were first raised, so bindings whose getters read
+// other properties see them change in the same order. The set only discards duplicates
+static TArray<FNoesisDeferredNotification> DeferredPropertyChangedNotifications;
+static TSet<FNoesisDeferredNotification> DeferredPropertyChangedNotificationSet;
+
+// Array wrappers are found by the address of the array they wrap. Arrays nested in a struct property are
+// found by their address inside the struct value
+static void ResetArrayItemCaches(UObject* Owner, FName PropertyName)
+{
+	if (ArrayMap.Num() == 0)
+		return;
+
+	FProperty* Property = Owner->GetClass()->FindPropertyByName(PropertyName);
+	if (Property == nullptr)
+		return;
+
+	uint8* ValueBegin = Property->ContainerPtrToValuePtr<uint8>(Owner);
+	if (Property->IsA<FArrayProperty>())
+	{
+		NoesisArrayWrapper** ArrayWrapperPtr = ArrayMap.Find(ValueBegin);
+		if (ArrayWrapperPtr)
+		{
+			(*ArrayWrapperPtr)->ResetItemCache();
+		}
+	}
+	else if (Property->IsA<FStructProperty>())
+	{
+		uint8* ValueEnd = ValueBegin + Property->GetSize();
+		for (const TPair<void*, NoesisArrayWrapper*>& Pair : ArrayMap)
+		{
+			if ((uint8*)Pair.Key >= ValueBegin && (uint8*)Pair.Key < ValueEnd)
+			{
+				Pair.Value->ResetItemCache();
+			}
+		}
+	}
+}
+
+static void RaisePropertyChanged(UObject* Owner, FName PropertyName)
 {
-	SCOPE_CYCLE_COUNTER(STAT_NoesisNotifyPropertyChanged);
 	NoesisObjectWrapper** WrapperPtr = ObjectMap.Find(Owner);
 	if (WrapperPtr)
 	{
 		NoesisObjectWrapper* Wrapper = *WrapperPtr;
-		auto PropertySymbol = Noesis::Symbol((ANSICHAR*)StringCast<UTF8CHAR>(*PropertyName.ToString()).Get());
+		auto PropertySymbol = NoesisSymbolForName(PropertyName);
 #if DO_CHECK // Skip in shipping build
 		const Noesis::TypeClass* WrapperTypeClass = Wrapper->GetClassType();
 		Noesis::TypeClassProperty ClassProperty = Noesis::FindProperty(WrapperTypeClass, PropertySymbol);
@@ -4045,10 +4338,59 @@ void NoesisNotifyPropertyChanged(UObject* Owner, FName PropertyName)
 				(ANSICHAR*)StringCast<UTF8CHAR>(*PropertyName.ToString()).Get());
 		}
 #endif
+		INC_DWORD_STAT(STAT_NoesisPropertyChangedNotificationsRaised);
 		Wrapper->NotifyPropertyChanged(PropertySymbol);
 	}
 }
 
+void NoesisNotifyPropertyChanged(UObject* Owner, FName PropertyName)
+{
+	SCOPE_CYCLE_COUNTER(STAT_NoesisNotifyPropertyChanged);
+	if (IsValid(Owner))
+	{
+		ResetArrayItemCaches(Owner, PropertyName);
+	}
+
+	if (GetDefault<UNoesisSettings>()->DeferPropertyChangedNotifications)
+	{
+		FNoesisDeferredNotification Notification(Owner, PropertyName);
+		bool AlreadyDeferred = false;
+		DeferredPropertyChangedNotificationSet.Add(Notification, &AlreadyDeferred);
+		if (AlreadyDeferred)
+		{
+			INC_DWORD_STAT(STAT_NoesisPropertyChangedNotificationsCoalesced);
+		}
+		else
+		{
+			DeferredPropertyChangedNotifications.Add(Notification);
+		}
+		return;
+	}
+
+	RaisePropertyChanged(Owner, PropertyName);
+}
+
+void NoesisFlushPropertyChangedNotifications()
+{
+	if (DeferredPropertyChangedNotifications.Num() == 0)
+		return;
+
+	SCOPE_CYCLE_COUNTER(STAT_NoesisFlushPropertyChangedNotifications);
+
+	// Notifications raised by bindings while flushing are deferred to the next flush
+	TArray<FNoesisDeferredNotification> Notifications = MoveTemp(DeferredPropertyChangedNotifications);
+	DeferredPropertyChangedNotifications.Reset();
+	DeferredPropertyChangedNotificationSet.Reset();
+
+	for (const FNoesisDeferredNotification& Notification : Notifications)
+	{
+		if (UObject* Owner = Notification.Key.Get())
+		{
+			RaisePropertyChanged(Owner, Notification.Value);
+		}
+	}
+}
+
 void NoesisNotifyArrayPropertyChanged(UObject* Owner, FName ArrayPropertyName)
 {
 	SCOPE_CYCLE_COUNTER(STAT_NoesisNotifyArrayPropertyChanged);
@@ -4306,6 +4648,8 @@ void NoesisDeleteMaps()
 {
 	NoesisIsShuttingDown = true;
 
+	PreregisteredClasses.Reset();
+
 	for (auto Pair : ClassMap)
 	{
 		ReplaceTypeClass(Pair.Value, nullptr);
@@ -4335,12 +4679,58 @@ void NoesisDeleteMaps()
 		delete TypeClass;
 	}
 	DeletedTypes.Empty();
+
+	SymbolMap.Empty();
+	DeferredPropertyChangedNotifications.Empty();
+	DeferredPropertyChangedNotificationSet.Empty();
+}
+
+// Symbols of the text properties and text getters of a class, which are notified when the culture changes
+static const TArray<Noesis::Symbol>& GetCultureTextProperties(UClass* Class, TMap<UClass*, TArray<Noesis::Symbol>>& ClassTextProperties)
+{
+	if (const TArray<Noesis::Symbol>* TextPropertiesPtr = ClassTextProperties.Find(Class))
+	{
+		return *TextPropertiesPtr;
+	}
+
+	TArray<Noesis::Symbol>& TextProperties = ClassTextProperties.Add(Class);
+
+	for (TFieldIterator<FProperty> PropertyIt(Class, EFieldIteratorFlags::IncludeSuper); PropertyIt; ++PropertyIt)
+	{
+		FProperty* Property = *PropertyIt;
+		if (Property->IsA<FTextProperty>())
+		{
+			TextProperties.Add(NoesisSymbolForName(Property->GetFName()));
+		}
+	}
+
+	for (TFieldIterator<UFunction> FunctionIt(Class, EFieldIteratorFlags::IncludeSuper); FunctionIt; ++FunctionIt)
+	{
+		UFunction* Function = *FunctionIt;
+		if (Function->GetName().StartsWith(TEXT("Get")) && Function->NumParms == 1 &&
+			(Function->HasAnyFunctionFlags(FUNC_HasOutParms) || Function->GetReturnProperty() != nullptr))
+		{
+			FProperty* OutParam = CastField<FProperty>(Function->ChildProperties);
+
+			if (OutParam->IsA<FTextProperty>())
+			{
+				TextProperties.Add(NoesisSymbolForName(FName(*Function->GetName().RightChop(3))));
+			}
+		}
+	}
+
+	return TextProperties;
 }
 
 void NoesisCultureChanged()
 {
 	if (GIsRunning)
 	{
+		SCOPE_CYCLE_COUNTER(STAT_NoesisCultureChanged);
+
+		// Objects of the same class share the reflection walk
+		TMap<UClass*, TArray<Noesis::Symbol>> ClassTextProperties;
+
 		for (auto It = ObjectMap.CreateIterator(); It; ++It)
 		{
 			auto& ObjectComponentPair = *It;
@@ -4348,40 +4738,17 @@ void NoesisCultureChanged()
 			if (IsValid(Object) && !Object->IsUnreachable())
 			{
 				NoesisObjectWrapper* Wrapper = ObjectComponentPair.Value;
-				UClass* Class = Object->GetClass();
-
-				for (TFieldIterator<FProperty> PropertyIt(Class, EFieldIteratorFlags::IncludeSuper); PropertyIt; ++PropertyIt)
-				{
-					FProperty* Property = *PropertyIt;
-					if (Property->IsA<FTextProperty>())
-					{
-						FString PropertyName = Property->GetName();
-						Noesis::Symbol PropertyId = Noesis::Symbol((ANSICHAR*)StringCast<UTF8CHAR>(*PropertyName).Get());
+				const TArray<Noesis::Symbol>& TextProperties = GetCultureTextProperties(Object->GetClass(), ClassTextProperties);
 
-						Wrapper->NotifyPropertyChanged(PropertyId);
-					}
-				}
-
-				for (TFieldIterator<UFunction> FunctionIt(Class, EFieldIteratorFlags::IncludeSuper); FunctionIt; ++FunctionIt)
+				for (Noesis::Symbol PropertyId : TextProperties)
 				{
-					UFunction* Function = *FunctionIt;
-					if (Function->GetName().StartsWith(TEXT("Get")) && Function->NumParms == 1 &&
-						(Function->HasAnyFunctionFlags(FUNC_HasOutParms) || Function->GetReturnProperty() != nullptr))
-					{
-						FProperty* OutParam = CastField<FProperty>(Function->ChildProperties);
-
-						if (OutParam->IsA<FTextProperty>())
-						{
-							FString PropertyName = Function->GetName().RightChop(3);
-							Noesis::Symbol PropertyId = Noesis::Symbol((ANSICHAR*)StringCast<UTF8CHAR>(*PropertyName).Get());
-
-							Wrapper->NotifyPropertyChanged(PropertyId);
-						}
-					}
+					Wrapper->NotifyPropertyChanged(PropertyId);
 				}
 			}
 		}
 	}
+
+	LocCultureListener::NotifyCultureChanged();
 }
 
 void NoesisGarbageCollected()
@@ -4389,6 +4756,9 @@ void NoesisGarbageCollected()
 	if (GIsRunning)
 	{
 		SCOPE_CYCLE_COUNTER(STAT_NoesisGarbageCollected);
+
+		// Wrappers of unreachable objects are detached right away, because incremental purge can take several frames.
+		// Unreachable objects are never wrapped again, so nothing is left to release when they are purged
 		for (auto It = ObjectMap.CreateIterator(); It; ++It)
 		{
 			auto& ObjectComponentPair = *It;
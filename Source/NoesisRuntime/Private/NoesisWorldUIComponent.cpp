@@ -5,17 +5,67 @@
 
 #include "NoesisWorldUIComponent.h"
 
+// Core includes
+#include "Stats/Stats.h"
+#include "Algo/StableSort.h"
+
+// Engine includes
+#include "ConvexVolume.h"
+#include "Engine/Engine.h"
+
 // UMG includes
 #include "Blueprint/UserWidget.h"
 
 // NoesisRuntime includes
+#include "NoesisRuntimeModule.h"
+#include "NoesisSettings.h"
 #include "NoesisSupport.h"
 #include "NoesisTypeClass.h"
 #include "NoesisXaml.h"
 
+DECLARE_CYCLE_STAT(TEXT("UpdateWorldUIComponents"), STAT_NoesisUpdateWorldUIComponents, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("WorldUI Components"), STAT_NoesisWorldUIComponents, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("WorldUI Components Culled"), STAT_NoesisWorldUIComponentsCulled, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("WorldUI Depth Sorts"), STAT_NoesisWorldUIDepthSorts, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("WorldUI ZIndex Changes"), STAT_NoesisWorldUIZIndexChanges, STATGROUP_Noesis);
+
+// Components with an element added to the WorldUI view of a world
+struct FNoesisWorldUIComponents
+{
+	TArray<UNoesisWorldUIComponent*> Components;
+
+	// Camera used by the last depth sort, and whether any component moved, appeared or disappeared since then
+	FVector SortViewLocation = FVector::ZeroVector;
+	FRotator SortViewRotation = FRotator::ZeroRotator;
+	bool OrderDirty = true;
+};
+
+static TMap<UWorld*, FNoesisWorldUIComponents> WorldComponents;
+
+static void InvalidateWorldComponentsOrder(UWorld* World)
+{
+	FNoesisWorldUIComponents* WorldUIComponents = WorldComponents.Find(World);
+	if (WorldUIComponents != nullptr)
+	{
+		WorldUIComponents->OrderDirty = true;
+	}
+}
+
 UNoesisWorldUIComponent::UNoesisWorldUIComponent(): Xaml(nullptr), Scale(1.0f), Center(true)
 {
-	PrimaryComponentTick.bCanEverTick = true;
+	// Components are updated together by UpdateWorldComponents instead of ticking individually
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UNoesisWorldUIComponent::OnRegister()
+{
+	// Blueprint subclasses implementing Event Tick keep ticking. The flag has to be set before the tick function is registered
+	if (GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UNoesisWorldUIComponent, ReceiveTick)))
+	{
+		PrimaryComponentTick.bCanEverTick = true;
+	}
+
+	Super::OnRegister();
 }
 
 void UNoesisWorldUIComponent::Add3DElement()
@@ -32,6 +82,9 @@ void UNoesisWorldUIComponent::Add3DElement()
 		}
 		TransformUpdatedDelegateHandle = TransformUpdated.AddUObject(this, &UNoesisWorldUIComponent::OnTransformUpdated);
 		UNoesisInstance::Add3DElement(GetWorld(), Element);
+		FNoesisWorldUIComponents& WorldUIComponents = WorldComponents.FindOrAdd(GetWorld());
+		WorldUIComponents.Components.Add(this);
+		WorldUIComponents.OrderDirty = true;
 
 		OnTransformUpdated(this, EUpdateTransformFlags::None, ETeleportType::None);
 	}
@@ -41,9 +94,29 @@ void UNoesisWorldUIComponent::Remove3DElement()
 {
 	if (Element != nullptr)
 	{
-		UNoesisInstance::Remove3DElement(GetWorld(), Element);
+		// Culled elements were already taken out of the WorldUI view
+		if (!Culled)
+		{
+			UNoesisInstance::Remove3DElement(GetWorld(), Element);
+		}
 		TransformUpdated.Remove(TransformUpdatedDelegateHandle);
 		Element.Reset();
+
+		FNoesisWorldUIComponents* WorldUIComponents = WorldComponents.Find(GetWorld());
+		if (WorldUIComponents != nullptr)
+		{
+			WorldUIComponents->Components.RemoveSingleSwap(this);
+			WorldUIComponents->OrderDirty = true;
+			if (WorldUIComponents->Components.Num() == 0)
+			{
+				WorldComponents.Remove(GetWorld());
+			}
+		}
+
+		Culled = false;
+		TransformDirty = false;
+		BoundsRadius = 0.0f;
+		ZIndex = INDEX_NONE;
 	}
 }
 
@@ -61,22 +134,170 @@ void UNoesisWorldUIComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	Super::EndPlay(EndPlayReason);
 }
 
-void UNoesisWorldUIComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+FSphere UNoesisWorldUIComponent::UpdateWorldComponents(UWorld* World, const FMatrix* ViewProjectionMatrix, int32& NumVisibleComponents)
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	const FSphere UnknownBounds(FVector::ZeroVector, -1.0f);
+	NumVisibleComponents = 0;
 
-	FTransform Transform = GetComponentToWorld();
-	APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
-	FVector MonoLocation;
-	FRotator MonoRotation;
-	PlayerController->GetPlayerViewPoint(MonoLocation, MonoRotation);
-	FVector CameraForward = MonoRotation.RotateVector(FVector(-1.0f, 0.0f, 0.0f));
-	int32 ZIndex = (int32)CameraForward.Dot(Transform.GetLocation() - MonoLocation);
-	Element->SetValue<int32>(Noesis::Panel::ZIndexProperty, ZIndex);
+	FNoesisWorldUIComponents* WorldUIComponents = WorldComponents.Find(World);
+	if (WorldUIComponents == nullptr)
+		return UnknownBounds;
+
+	SCOPE_CYCLE_COUNTER(STAT_NoesisUpdateWorldUIComponents);
+	TArray<UNoesisWorldUIComponent*>& Components = WorldUIComponents->Components;
+	INC_DWORD_STAT_BY(STAT_NoesisWorldUIComponents, Components.Num());
+
+	// The camera is queried once for all the components
+	APlayerController* PlayerController = World->GetFirstPlayerController();
+	if (PlayerController == nullptr)
+		return UnknownBounds;
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	FConvexVolume ViewFrustum;
+	if (ViewProjectionMatrix != nullptr)
+	{
+		GetViewFrustumBounds(ViewFrustum, *ViewProjectionMatrix, false);
+	}
+
+	// Elements are shared by the views of all the local players, so they are only culled with a single one
+	bool CanCull = GEngine->GetNumGamePlayers(World) <= 1;
+
+	// The renderer uses the bounds of the visible components to skip the views that can't see any of them
+	FSphere VisibleBounds(ForceInit);
+	for (UNoesisWorldUIComponent* Component : Components)
+	{
+		if (Component->UpdateCulling(CanCull ? &ViewLocation : nullptr, CanCull && ViewProjectionMatrix != nullptr ? &ViewFrustum : nullptr))
+		{
+			WorldUIComponents->OrderDirty = true;
+		}
+
+		if (!Component->Culled)
+		{
+			NumVisibleComponents++;
+		}
+
+		if (!Component->Culled && VisibleBounds.W >= 0.0f)
+		{
+			VisibleBounds = Component->BoundsRadius > 0.0f ? VisibleBounds + FSphere(Component->GetComponentLocation(), Component->BoundsRadius) : UnknownBounds;
+		}
+	}
+
+	// Depth order only changes when components move, appear or disappear, or when the camera moves
+	float SortThreshold = GetDefault<UNoesisSettings>()->WorldUISortThreshold;
+	bool ViewMoved = FVector::DistSquared(ViewLocation, WorldUIComponents->SortViewLocation) > FMath::Square(SortThreshold) ||
+		!ViewRotation.Equals(WorldUIComponents->SortViewRotation);
+	if (!WorldUIComponents->OrderDirty && !ViewMoved)
+		return VisibleBounds;
+
+	WorldUIComponents->SortViewLocation = ViewLocation;
+	WorldUIComponents->SortViewRotation = ViewRotation;
+	WorldUIComponents->OrderDirty = false;
+	INC_DWORD_STAT(STAT_NoesisWorldUIDepthSorts);
+
+	// Visible elements are sorted back to front in a single pass and get consecutive ZIndex values, so moving
+	// elements only invalidate the panel when their position in the order actually changes
+	FVector ViewForward = ViewRotation.Vector();
+	TArray<TPair<float, UNoesisWorldUIComponent*>, TInlineAllocator<64>> SortedComponents;
+	SortedComponents.Reserve(Components.Num());
+	for (UNoesisWorldUIComponent* Component : Components)
+	{
+		if (!Component->Culled)
+		{
+			float Depth = ViewForward.Dot(Component->GetComponentLocation() - ViewLocation);
+			SortedComponents.Emplace(Depth, Component);
+		}
+	}
+
+	Algo::StableSort(SortedComponents, [](const TPair<float, UNoesisWorldUIComponent*>& A, const TPair<float, UNoesisWorldUIComponent*>& B)
+	{
+		return A.Key > B.Key;
+	});
+
+	for (int32 Index = 0; Index < SortedComponents.Num(); ++Index)
+	{
+		UNoesisWorldUIComponent* Component = SortedComponents[Index].Value;
+		if (Component->ZIndex != Index)
+		{
+			Component->ZIndex = Index;
+			Component->Element->SetValue<int32>(Noesis::Panel::ZIndexProperty, Index);
+			INC_DWORD_STAT(STAT_NoesisWorldUIZIndexChanges);
+		}
+	}
+
+	return VisibleBounds;
+}
+
+bool UNoesisWorldUIComponent::UpdateCulling(const FVector* ViewLocation, const FConvexVolume* ViewFrustum)
+{
+	FVector Location = GetComponentLocation();
+
+	if (!Culled)
+	{
+		// Bounding sphere of the element as laid out in the last update, centered or not
+		float Width = Element->GetActualWidth();
+		float Height = Element->GetActualHeight();
+		if (Width > 0.0f && Height > 0.0f)
+		{
+			BoundsRadius = Scale * GetComponentScale().GetAbsMax() * FMath::Sqrt(Width * Width + Height * Height);
+		}
+	}
+
+	bool InRange = MaxDrawDistance <= 0.0f || ViewLocation == nullptr || FVector::DistSquared(Location, *ViewLocation) <= FMath::Square(MaxDrawDistance);
+	bool InView = !CullOutsideView || ViewFrustum == nullptr || BoundsRadius <= 0.0f || ViewFrustum->IntersectSphere(Location, BoundsRadius);
+	bool WasCulled = Culled;
+	SetCulled(!InRange || !InView);
+
+	if (Culled)
+	{
+		INC_DWORD_STAT(STAT_NoesisWorldUIComponentsCulled);
+	}
+
+	return WasCulled != Culled;
+}
+
+void UNoesisWorldUIComponent::SetCulled(bool InCulled)
+{
+	if (Culled == InCulled)
+		return;
+
+	Culled = InCulled;
+
+	// Culled elements are taken out of the WorldUI view instead of collapsed, so their Visibility stays
+	// under the control of the XAML bindings and the game
+	if (Culled)
+	{
+		UNoesisInstance::Remove3DElement(GetWorld(), Element);
+	}
+	else
+	{
+		UNoesisInstance::Add3DElement(GetWorld(), Element);
+		if (TransformDirty)
+		{
+			UpdateTransform();
+		}
+	}
 }
 
 void UNoesisWorldUIComponent::OnTransformUpdated(USceneComponent*, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
 {
+	// Culled elements are measured and transformed when they become visible again
+	if (Culled)
+	{
+		TransformDirty = true;
+		return;
+	}
+
+	UpdateTransform();
+	InvalidateWorldComponentsOrder(GetWorld());
+}
+
+void UNoesisWorldUIComponent::UpdateTransform()
+{
+	TransformDirty = false;
+
 	FTransform Transform = GetComponentToWorld();
 	FMatrix Matrix = Transform.ToMatrixWithScale();
 
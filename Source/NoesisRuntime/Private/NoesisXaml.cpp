@@ -11,6 +11,8 @@
 
 // Engine includes
 #include "EditorFramework/AssetImportData.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 #include "Engine/Font.h"
 #include "Engine/FontFace.h"
 #include "Engine/World.h"
@@ -38,18 +40,27 @@ void UNoesisXaml::LoadComponent(Noesis::BaseComponent* Component)
 	Noesis::GUI::LoadComponent(Component, (ANSICHAR*)StringCast<UTF8CHAR>(*Uri).Get());
 }
 
-uint32 UNoesisXaml::GetContentHash() const
+// Each XAML in the dependency graph is hashed once, so shared dictionaries reached through several paths
+// aren't hashed again for every path, and cycles terminate
+static void HashContentRecursive(const UNoesisXaml* Xaml, TSet<const UNoesisXaml*>& Visited, uint32& Hash)
 {
-	uint32 Hash = Noesis::HashBytes(XamlText.GetData(), XamlText.Num());
+	if (Xaml == nullptr || Visited.Contains(Xaml))
+		return;
+
+	Visited.Add(Xaml);
+	Hash = HashCombine(Hash, Noesis::HashBytes(Xaml->XamlText.GetData(), Xaml->XamlText.Num()));
 
-	for (auto Xaml : Xamls)
+	for (auto Dependency : Xaml->Xamls)
 	{
-		if (Xaml != nullptr)
-		{
-			Hash ^= Xaml->GetContentHash();
-		}
+		HashContentRecursive(Dependency, Visited, Hash);
 	}
+}
 
+uint32 UNoesisXaml::GetContentHash() const
+{
+	TSet<const UNoesisXaml*> Visited;
+	uint32 Hash = 0;
+	HashContentRecursive(this, Visited, Hash);
 	return Hash;
 }
 
@@ -64,6 +75,95 @@ void UNoesisXaml::PostInitProperties()
 	Super::PostInitProperties();
 }
 
+static bool IsXamlWhitespace(uint8 Char)
+{
+	return Char == ' ' || Char == '\t' || Char == '\r' || Char == '\n';
+}
+
+static bool XamlTextMatches(const TArray<uint8>& Text, int32 Index, const char* Token)
+{
+	int32 Length = FCStringAnsi::Strlen(Token);
+	return Index + Length <= Text.Num() && FMemory::Memcmp(Text.GetData() + Index, Token, Length) == 0;
+}
+
+static int32 CopyXamlTextUntil(const TArray<uint8>& Text, int32 Index, const char* Token, TArray<uint8>* Out)
+{
+	int32 Length = FCStringAnsi::Strlen(Token);
+	int32 End = Index;
+	while (End < Text.Num() && !XamlTextMatches(Text, End, Token))
+	{
+		++End;
+	}
+	End = FMath::Min(End + Length, Text.Num());
+
+	if (Out != nullptr)
+	{
+		Out->Append(Text.GetData() + Index, End - Index);
+	}
+	return End;
+}
+
+// Strips comments and collapses whitespace runs outside attribute values and CDATA sections to a single
+// space, which XAML whitespace normalization does anyway. Documents using xml:space are left untouched.
+// The cooked output stays XAML text because the Noesis parser doesn't accept any pre-tokenized input
+static TArray<uint8> CompactXamlText(const TArray<uint8>& Text)
+{
+	TArray<uint8> Out;
+	Out.Reserve(Text.Num());
+
+	for (int32 Index = 0; Index < Text.Num(); ++Index)
+	{
+		if (XamlTextMatches(Text, Index, "xml:space"))
+		{
+			return Text;
+		}
+	}
+
+	bool InTag = false;
+	uint8 Quote = 0;
+	int32 Index = 0;
+	while (Index < Text.Num())
+	{
+		uint8 Char = Text[Index];
+
+		if (Quote != 0)
+		{
+			Out.Add(Char);
+			Quote = Char == Quote ? 0 : Quote;
+			++Index;
+		}
+		else if (!InTag && XamlTextMatches(Text, Index, "<!--"))
+		{
+			Index = CopyXamlTextUntil(Text, Index, "-->", nullptr);
+		}
+		else if (!InTag && XamlTextMatches(Text, Index, "<![CDATA["))
+		{
+			Index = CopyXamlTextUntil(Text, Index, "]]>", &Out);
+		}
+		else if (!InTag && XamlTextMatches(Text, Index, "<?"))
+		{
+			Index = CopyXamlTextUntil(Text, Index, "?>", &Out);
+		}
+		else if (IsXamlWhitespace(Char))
+		{
+			while (Index < Text.Num() && IsXamlWhitespace(Text[Index]))
+			{
+				++Index;
+			}
+			Out.Add(' ');
+		}
+		else
+		{
+			InTag = Char == '<' ? true : Char == '>' ? false : InTag;
+			Quote = InTag && (Char == '"' || Char == '\'') ? Char : 0;
+			Out.Add(Char);
+			++Index;
+		}
+	}
+
+	return Out;
+}
+
 #if UE_VERSION_OLDER_THAN(5, 4, 0)
 void UNoesisXaml::GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const
 {
@@ -87,6 +187,26 @@ void UNoesisXaml::GetAssetRegistryTags(FAssetRegistryTagsContext Context) const
 #endif
 #endif // WITH_EDITORONLY_DATA
 
+void UNoesisXaml::Serialize(FArchive& Ar)
+{
+#if WITH_EDITORONLY_DATA
+	// Cooked packages only store the compacted text, the editor object keeps the original
+	if (Ar.IsSaving() && Ar.IsCooking())
+	{
+		TArray<uint8> CompactText = CompactXamlText(XamlText);
+		if (CompactText.Num() < XamlText.Num())
+		{
+			Swap(XamlText, CompactText);
+			Super::Serialize(Ar);
+			Swap(XamlText, CompactText);
+			return;
+		}
+	}
+#endif
+
+	Super::Serialize(Ar);
+}
+
 void UNoesisXaml::RegisterDependencies()
 {
 	INoesisRuntimeModuleInterface& NoesisRuntime = INoesisRuntimeModuleInterface::Get();
@@ -108,6 +228,39 @@ void UNoesisXaml::RegisterDependencies()
 	{
 		NoesisRuntime.RegisterFont(FontFace);
 	}
+
+	for (auto Sound : Sounds)
+	{
+		NoesisRuntime.RegisterSound(Sound);
+	}
+}
+
+static void RegisterDependenciesRecursive(UNoesisXaml* Xaml, TSet<UNoesisXaml*>& Visited)
+{
+	if (Xaml == nullptr || Visited.Contains(Xaml))
+		return;
+
+	Visited.Add(Xaml);
+	Xaml->RegisterDependencies();
+
+	for (auto Dependency : Xaml->Xamls)
+	{
+		RegisterDependenciesRecursive(Dependency, Visited);
+	}
+}
+
+TSharedPtr<FStreamableHandle> UNoesisXaml::PreloadXaml(const TSoftObjectPtr<UNoesisXaml>& Xaml, FSimpleDelegate OnPreloaded)
+{
+	static FStreamableManager NoesisStreamableManager;
+	FStreamableManager& StreamableManager = UAssetManager::IsInitialized() ? UAssetManager::GetStreamableManager() : NoesisStreamableManager;
+
+	// The dependency arrays are hard references, so they are streamed in with the XAML package
+	return StreamableManager.RequestAsyncLoad(Xaml.ToSoftObjectPath(), FStreamableDelegate::CreateLambda([Xaml, OnPreloaded]()
+	{
+		TSet<UNoesisXaml*> Visited;
+		RegisterDependenciesRecursive(Xaml.Get(), Visited);
+		OnPreloaded.ExecuteIfBound();
+	}));
 }
 
 FString UNoesisXaml::GetXamlUri() const
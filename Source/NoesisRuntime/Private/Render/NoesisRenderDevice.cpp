@@ -56,6 +56,21 @@
 #include "Render/NoesisShaders.h"
 #include "NoesisSettings.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pipeline State Cache Hits"), STAT_NoesisPipelineStateCacheHits, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pipeline State Cache Misses"), STAT_NoesisPipelineStateCacheMisses, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pipeline State Changes Skipped"), STAT_NoesisPipelineStateChangesSkipped, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dynamic Buffer Locks"), STAT_NoesisDynamicBufferLocks, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dynamic Buffer Discards"), STAT_NoesisDynamicBufferDiscards, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dynamic Buffer Bytes"), STAT_NoesisDynamicBufferBytes, STATGROUP_Noesis);
+DECLARE_MEMORY_STAT(TEXT("Dynamic Buffer Memory"), STAT_NoesisDynamicBufferMemory, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Uniform Buffer Creations"), STAT_NoesisUniformBufferCreations, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Uniform Buffer Updates"), STAT_NoesisUniformBufferUpdates, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Uniform Buffer Reuses"), STAT_NoesisUniformBufferReuses, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Render Target Pool Hits"), STAT_NoesisRenderTargetPoolHits, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Render Target Pool Misses"), STAT_NoesisRenderTargetPoolMisses, STATGROUP_Noesis);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Render Targets"), STAT_NoesisPooledRenderTargets, STATGROUP_Noesis);
+DECLARE_MEMORY_STAT(TEXT("Render Target Pool Memory"), STAT_NoesisRenderTargetPoolMemory, STATGROUP_Noesis);
+
 class FNoesisTexture : public Noesis::Texture
 {
 public:
@@ -262,15 +277,132 @@ private:
 #endif
 };
 
+// Keeps the textures of released render targets around so they can be reused by the next render
+// target of the same size. When the pool is full the least recently released textures are evicted.
+class FNoesisRenderTargetPool
+{
+public:
+	FNoesisRenderTargetPool(uint32 InMaxSize)
+		: MaxSize(InMaxSize)
+	{
+	}
+
+	~FNoesisRenderTargetPool()
+	{
+		while (Entries.Num() > 0)
+		{
+			Evict(0);
+		}
+	}
+
+	static uint64 GetKey(uint32 Width, uint32 Height, uint32 SampleCount, bool DepthStencil)
+	{
+		return (uint64)Width | ((uint64)Height << 20) | ((uint64)SampleCount << 40) | ((uint64)DepthStencil << 48);
+	}
+
+	bool Acquire(uint64 Key, FTextureRHIRef& OutTarget, FTextureRHIRef& OutShaderResourceTexture)
+	{
+		FScopeLock Lock(&CriticalSection);
+
+		// Most recently released first
+		for (int32 Index = Entries.Num() - 1; Index >= 0; --Index)
+		{
+			FEntry& Entry = Entries[Index];
+			if (Entry.Key == Key)
+			{
+				OutTarget = MoveTemp(Entry.Target);
+				OutShaderResourceTexture = MoveTemp(Entry.ShaderResourceTexture);
+				DEC_DWORD_STAT(STAT_NoesisPooledRenderTargets);
+				DEC_MEMORY_STAT_BY(STAT_NoesisRenderTargetPoolMemory, Entry.Size);
+				Entries.RemoveAt(Index);
+				INC_DWORD_STAT(STAT_NoesisRenderTargetPoolHits);
+				return true;
+			}
+		}
+
+		INC_DWORD_STAT(STAT_NoesisRenderTargetPoolMisses);
+		return false;
+	}
+
+	void Release(uint64 Key, FRHITexture* Target, FRHITexture* ShaderResourceTexture)
+	{
+		FScopeLock Lock(&CriticalSection);
+
+		if (Entries.Num() >= (int32)MaxSize)
+		{
+			Evict(0);
+		}
+
+		uint32 Size = GetTextureSize(Target);
+		if (ShaderResourceTexture != nullptr && ShaderResourceTexture != Target)
+		{
+			Size += GetTextureSize(ShaderResourceTexture);
+		}
+
+		Entries.Add({ Key, Target, ShaderResourceTexture, Size });
+		INC_DWORD_STAT(STAT_NoesisPooledRenderTargets);
+		INC_MEMORY_STAT_BY(STAT_NoesisRenderTargetPoolMemory, Size);
+	}
+
+private:
+	struct FEntry
+	{
+		uint64 Key;
+		FTextureRHIRef Target;
+		FTextureRHIRef ShaderResourceTexture;
+		uint32 Size;
+	};
+
+	static uint32 GetTextureSize(FRHITexture* Texture)
+	{
+		if (EnumHasAnyFlags(Texture->GetFlags(), TexCreate_Memoryless))
+			return 0;
+
+		FIntVector Extent = Texture->GetSizeXYZ();
+		return (uint32)(Extent.X * Extent.Y) * GPixelFormats[Texture->GetFormat()].BlockBytes * Texture->GetNumSamples();
+	}
+
+	void Evict(int32 Index)
+	{
+		DEC_DWORD_STAT(STAT_NoesisPooledRenderTargets);
+		DEC_MEMORY_STAT_BY(STAT_NoesisRenderTargetPoolMemory, Entries[Index].Size);
+		Entries.RemoveAt(Index);
+	}
+
+	FCriticalSection CriticalSection;
+	TArray<FEntry> Entries; // Least recently released first
+	uint32 MaxSize;
+};
+
 class FNoesisRenderTarget : public Noesis::RenderTarget
 {
 public:
 
-	FNoesisRenderTarget(FRHITexture* InShaderResourceTexture, FRHITexture* InColorTarget, FRHITexture* InDepthStencilTarget)
-		: Texture(Noesis::MakePtr<FNoesisTexture>(InShaderResourceTexture)), ColorTarget(InColorTarget), DepthStencilTarget(InDepthStencilTarget)
+	FNoesisRenderTarget(FRHITexture* InShaderResourceTexture, FRHITexture* InColorTarget, FRHITexture* InDepthStencilTarget,
+		const TSharedPtr<FNoesisRenderTargetPool, ESPMode::ThreadSafe>& InPool, uint64 InColorTargetKey, uint64 InDepthStencilTargetKey)
+		: Texture(Noesis::MakePtr<FNoesisTexture>(InShaderResourceTexture)), ColorTarget(InColorTarget), DepthStencilTarget(InDepthStencilTarget),
+		Pool(InPool), ColorTargetKey(InColorTargetKey), DepthStencilTargetKey(InDepthStencilTargetKey)
 	{
 	}
 
+	~FNoesisRenderTarget()
+	{
+		if (TSharedPtr<FNoesisRenderTargetPool, ESPMode::ThreadSafe> PinnedPool = Pool.Pin())
+		{
+			// Don't recycle the textures if someone else is still holding the texture.
+			if (Texture->GetNumReferences() == 1)
+			{
+				PinnedPool->Release(ColorTargetKey, ColorTarget, Texture->GetTexture2D());
+			}
+
+			// Cloned render targets share the depth stencil target with the original one.
+			if (DepthStencilTargetKey != 0)
+			{
+				PinnedPool->Release(DepthStencilTargetKey, DepthStencilTarget, nullptr);
+			}
+		}
+	}
+
 	FRHITexture* GetShaderResourceTexture()
 	{
 		return Texture->GetTexture2D();
@@ -390,6 +522,9 @@ private:
 	Noesis::Ptr<FNoesisTexture> Texture;
 	FTextureRHIRef ColorTarget;
 	FTextureRHIRef DepthStencilTarget;
+	TWeakPtr<FNoesisRenderTargetPool, ESPMode::ThreadSafe> Pool;
+	uint64 ColorTargetKey = 0;
+	uint64 DepthStencilTargetKey = 0;
 };
 
 static const TCHAR* NoesisGlobalPSOCollectorName = TEXT("NoesisGlobalPSOCollector");
@@ -569,34 +704,107 @@ static FRHISamplerState* GetSamplerState(uint8 State)
 	return SamplerStates[State];
 }
 
+void FNoesisDynamicBufferRing::Init(uint32 InSize, uint32 InNumFramesInFlight)
+{
+	Size = InSize;
+	NumFramesInFlight = InNumFramesInFlight;
+	Head = 0;
+	Frame = 0;
+	FrameStarts.Reset();
+	FrameStarts.Add(0);
+}
+
+uint32 FNoesisDynamicBufferRing::Allocate(uint32 Bytes, bool& OutDiscard)
+{
+	check(Bytes <= Size);
+
+	if (Frame != GFrameCounterRenderThread)
+	{
+		Frame = GFrameCounterRenderThread;
+		if ((uint32)FrameStarts.Num() >= NumFramesInFlight)
+		{
+			// The oldest frame is no longer in flight, its data can be overwritten.
+			FrameStarts.RemoveAt(0, FrameStarts.Num() - NumFramesInFlight + 1);
+		}
+		FrameStarts.Add(Head);
+	}
+
+	// Stream source offsets must be aligned. Allocations never straddle the end of the buffer.
+	uint64 Start = Align(Head, 16);
+	uint32 Offset = (uint32)(Start % Size);
+	if (Offset + Bytes > Size)
+	{
+		Start += Size - Offset;
+		Offset = 0;
+	}
+
+	if (Start + Bytes - FrameStarts[0] > Size)
+	{
+		// The frames in flight don't leave enough room. Discarding gives us a fresh buffer.
+		OutDiscard = true;
+		Head = Bytes;
+		FrameStarts.Reset();
+		FrameStarts.Add(0);
+		return 0;
+	}
+
+	OutDiscard = false;
+	Head = Start + Bytes;
+	return Offset;
+}
+
 FNoesisRenderDevice::FNoesisRenderDevice(bool LinearColor)
 	: IsLinearColor(LinearColor)
 {
 	auto VBName = TEXT("Noesis.VertexBuffer");
 	auto IBName = TEXT("Noesis.IndexBuffer");
+	uint32 VBSize = DYNAMIC_VB_SIZE;
+	uint32 IBSize = DYNAMIC_IB_SIZE;
+	EBufferUsageFlags Usage = BUF_Volatile;
+#if !UE_VERSION_OLDER_THAN(5, 3, 0)
+	// Sub-allocating from the buffers requires RLM_WriteOnly_NoOverwrite locks.
+	const UNoesisSettings* Settings = GetDefault<UNoesisSettings>();
+	const uint32 NumFramesInFlight = (uint32)FMath::Max(0, Settings->DynamicBufferFramesInFlight);
+	if (NumFramesInFlight > 0)
+	{
+		VBSize = FMath::Max(VBSize, (uint32)FMath::Max(0, Settings->DynamicVertexBufferSize) * 1024);
+		IBSize = FMath::Max(IBSize, (uint32)FMath::Max(0, Settings->DynamicIndexBufferSize) * 1024);
+		VertexBufferRing.Init(VBSize, NumFramesInFlight);
+		IndexBufferRing.Init(IBSize, NumFramesInFlight);
+		Usage = BUF_Dynamic;
+	}
+#endif
 #if UE_VERSION_OLDER_THAN(5, 6, 0)
 	FRHIResourceCreateInfo CreateInfo(VBName);
 #if UE_VERSION_OLDER_THAN(5, 3, 0)
-	DynamicVertexBuffer = RHICreateVertexBuffer(DYNAMIC_VB_SIZE, BUF_Volatile, CreateInfo);
+	DynamicVertexBuffer = RHICreateVertexBuffer(VBSize, Usage, CreateInfo);
 #else
-	DynamicVertexBuffer = FRHICommandListExecutor::GetImmediateCommandList().CreateVertexBuffer(DYNAMIC_VB_SIZE, BUF_Volatile, CreateInfo);
+	DynamicVertexBuffer = FRHICommandListExecutor::GetImmediateCommandList().CreateVertexBuffer(VBSize, Usage, CreateInfo);
 #endif
 	CreateInfo.DebugName = IBName;
 #if UE_VERSION_OLDER_THAN(5, 3, 0)
-	DynamicIndexBuffer = RHICreateIndexBuffer(sizeof(int16), DYNAMIC_IB_SIZE, BUF_Volatile, CreateInfo);
+	DynamicIndexBuffer = RHICreateIndexBuffer(sizeof(int16), IBSize, Usage, CreateInfo);
 #else
-	DynamicIndexBuffer = FRHICommandListExecutor::GetImmediateCommandList().CreateIndexBuffer(sizeof(int16), DYNAMIC_IB_SIZE, BUF_Volatile, CreateInfo);
+	DynamicIndexBuffer = FRHICommandListExecutor::GetImmediateCommandList().CreateIndexBuffer(sizeof(int16), IBSize, Usage, CreateInfo);
 #endif
 #else
-	EBufferUsageFlags VBUsage = EBufferUsageFlags::Volatile | EBufferUsageFlags::VertexBuffer;
+	EBufferUsageFlags VBUsage = Usage | EBufferUsageFlags::VertexBuffer;
 	ERHIAccess VBState = RHIGetDefaultResourceState(VBUsage, false);
-	FRHIBufferCreateDesc VBDesc = FRHIBufferCreateDesc::Create(VBName, DYNAMIC_VB_SIZE, 0, VBUsage).SetInitialState(VBState);
+	FRHIBufferCreateDesc VBDesc = FRHIBufferCreateDesc::Create(VBName, VBSize, 0, VBUsage).SetInitialState(VBState);
 	DynamicVertexBuffer = FRHICommandListExecutor::GetImmediateCommandList().CreateBuffer(VBDesc);
-	EBufferUsageFlags IBUsage = EBufferUsageFlags::Volatile | EBufferUsageFlags::IndexBuffer;
+	EBufferUsageFlags IBUsage = Usage | EBufferUsageFlags::IndexBuffer;
 	ERHIAccess IBState = RHIGetDefaultResourceState(IBUsage, false);
-	FRHIBufferCreateDesc IBDesc = FRHIBufferCreateDesc::Create(IBName, DYNAMIC_IB_SIZE, sizeof(int16), IBUsage).SetInitialState(IBState);
+	FRHIBufferCreateDesc IBDesc = FRHIBufferCreateDesc::Create(IBName, IBSize, sizeof(int16), IBUsage).SetInitialState(IBState);
 	DynamicIndexBuffer = FRHICommandListExecutor::GetImmediateCommandList().CreateBuffer(IBDesc);
 #endif
+	DynamicBuffersMemory = VBSize + IBSize;
+	INC_MEMORY_STAT_BY(STAT_NoesisDynamicBufferMemory, DynamicBuffersMemory);
+
+	const uint32 RenderTargetPoolSize = (uint32)FMath::Max(0, GetDefault<UNoesisSettings>()->OffscreenPoolSize);
+	if (RenderTargetPoolSize > 0)
+	{
+		RenderTargetPool = MakeShared<FNoesisRenderTargetPool, ESPMode::ThreadSafe>(RenderTargetPoolSize);
+	}
 	NOESIS_BIND_DEBUG_BUFFER_LABEL(FRHICommandListExecutor::GetImmediateCommandList(), DynamicVertexBuffer, VBName);
 	NOESIS_BIND_DEBUG_BUFFER_LABEL(FRHICommandListExecutor::GetImmediateCommandList(), DynamicIndexBuffer, IBName);
 
@@ -830,6 +1038,7 @@ FNoesisRenderDevice::FNoesisRenderDevice(bool LinearColor)
 
 FNoesisRenderDevice::~FNoesisRenderDevice()
 {
+	DEC_MEMORY_STAT_BY(STAT_NoesisDynamicBufferMemory, DynamicBuffersMemory);
 	DynamicVertexBuffer.SafeRelease();
 	DynamicIndexBuffer.SafeRelease();
 	VSConstantBuffer.SafeRelease();
@@ -859,6 +1068,7 @@ FNoesisRenderDevice* FNoesisRenderDevice::Get()
 		NoesisRenderDevice->SetOffscreenMaxNumSurfaces((uint32)FMath::Max(0, GetDefault<UNoesisSettings>()->OffscreenMaxSurfaces));
 		NoesisRenderDevice->SetGlyphCacheWidth(GlyphCacheWidth[(uint8)GetDefault<UNoesisSettings>()->GlyphTextureSize]);
 		NoesisRenderDevice->SetGlyphCacheHeight(GlyphCacheHeight[(uint8)GetDefault<UNoesisSettings>()->GlyphTextureSize]);
+		NoesisRenderDevice->CachePipelineStates = GetDefault<UNoesisSettings>()->CachePipelineStates;
 	}
 	return NoesisRenderDevice;
 }
@@ -875,6 +1085,7 @@ FNoesisRenderDevice* FNoesisRenderDevice::GetLinear()
 		LinearNoesisRenderDevice->SetOffscreenMaxNumSurfaces((uint32)FMath::Max(0, GetDefault<UNoesisSettings>()->OffscreenMaxSurfaces));
 		LinearNoesisRenderDevice->SetGlyphCacheWidth(GlyphCacheWidth[(uint8)GetDefault<UNoesisSettings>()->GlyphTextureSize]);
 		LinearNoesisRenderDevice->SetGlyphCacheHeight(GlyphCacheHeight[(uint8)GetDefault<UNoesisSettings>()->GlyphTextureSize]);
+		LinearNoesisRenderDevice->CachePipelineStates = GetDefault<UNoesisSettings>()->CachePipelineStates;
 	}
 	return LinearNoesisRenderDevice;
 }
@@ -890,6 +1101,7 @@ void FNoesisRenderDevice::Destroy()
 void FNoesisRenderDevice::SetRHICmdList(FRHICommandList* InRHICmdList)
 {
 	RHICmdList = InRHICmdList;
+	InvalidateBoundPipelineState();
 }
 
 void FNoesisRenderDevice::SetWorldTime(FGameTime InWorldTime)
@@ -1129,19 +1341,24 @@ static void NoesisCreateTargetableShaderResource2D(
 	}
 }
 
-static Noesis::Ptr<Noesis::RenderTarget> CreateRenderTarget(const TCHAR* Name, uint32 Width, uint32 Height, uint32 SampleCount, FRHITexture* DepthStencilTarget, bool IsLinearColor)
+static Noesis::Ptr<Noesis::RenderTarget> CreateRenderTarget(const TCHAR* Name, uint32 Width, uint32 Height, uint32 SampleCount, FRHITexture* DepthStencilTarget, uint64 DepthStencilTargetKey, bool IsLinearColor,
+	const TSharedPtr<FNoesisRenderTargetPool, ESPMode::ThreadSafe>& Pool)
 {
-	EPixelFormat Format = PF_R8G8B8A8;
-	uint32 NumMips = 1;
-	ETextureCreateFlags Flags = IsLinearColor ? TexCreate_SRGB : TexCreate_None;
-	ETextureCreateFlags TargetableTextureFlags = TexCreate_RenderTargetable | (IsLinearColor ? TexCreate_SRGB : TexCreate_None);
-	bool bForceSeparateTargetAndShaderResource = false;
-	FClearValueBinding ClearValue;
+	uint64 ColorTargetKey = FNoesisRenderTargetPool::GetKey(Width, Height, SampleCount, false);
 	FTextureRHIRef ColorTarget;
 	FTextureRHIRef ShaderResourceTexture;
-	NoesisCreateTargetableShaderResource2D(Name, Width, Height, Format, NumMips, Flags, TargetableTextureFlags, bForceSeparateTargetAndShaderResource, false, ClearValue, ColorTarget, ShaderResourceTexture, SampleCount);
+	if (!Pool.IsValid() || !Pool->Acquire(ColorTargetKey, ColorTarget, ShaderResourceTexture))
+	{
+		EPixelFormat Format = PF_R8G8B8A8;
+		uint32 NumMips = 1;
+		ETextureCreateFlags Flags = IsLinearColor ? TexCreate_SRGB : TexCreate_None;
+		ETextureCreateFlags TargetableTextureFlags = TexCreate_RenderTargetable | (IsLinearColor ? TexCreate_SRGB : TexCreate_None);
+		bool bForceSeparateTargetAndShaderResource = false;
+		FClearValueBinding ClearValue;
+		NoesisCreateTargetableShaderResource2D(Name, Width, Height, Format, NumMips, Flags, TargetableTextureFlags, bForceSeparateTargetAndShaderResource, false, ClearValue, ColorTarget, ShaderResourceTexture, SampleCount);
+	}
 
-	FNoesisRenderTarget* RenderTarget = new FNoesisRenderTarget(ShaderResourceTexture, ColorTarget, DepthStencilTarget);
+	FNoesisRenderTarget* RenderTarget = new FNoesisRenderTarget(ShaderResourceTexture, ColorTarget, DepthStencilTarget, Pool, ColorTargetKey, DepthStencilTargetKey);
 
 	return Noesis::Ptr<Noesis::RenderTarget>(*RenderTarget);
 }
@@ -1151,35 +1368,41 @@ Noesis::Ptr<Noesis::RenderTarget> FNoesisRenderDevice::CreateRenderTarget(const
 	TStringBuilder<64> Name;
 	Name.Append(TEXT("Noesis.RenderTarget.")).Append(StringCast<TCHAR>((UTF8CHAR*)Label).Get());
 	FTextureRHIRef DepthStencilTarget;
+	uint64 DepthStencilTargetKey = 0;
 
 	if (NeedsStencil)
 	{
-		TStringBuilder<64> DSName;
-		DSName.Append(*Name).Append(TEXT("_DS"));
-		uint32 NumMips = 1;
-		EPixelFormat Format = PF_DepthStencil;
-		ETextureCreateFlags TargetableTextureFlags = TexCreate_DepthStencilTargetable | TexCreate_Memoryless;
-		ERHIAccess Access = ERHIAccess::DSVWrite;
-		FClearValueBinding ClearValue(0.f, 0);
+		DepthStencilTargetKey = FNoesisRenderTargetPool::GetKey(Width, Height, SampleCount, true);
+		FTextureRHIRef Unused;
+		if (!RenderTargetPool.IsValid() || !RenderTargetPool->Acquire(DepthStencilTargetKey, DepthStencilTarget, Unused))
+		{
+			TStringBuilder<64> DSName;
+			DSName.Append(*Name).Append(TEXT("_DS"));
+			uint32 NumMips = 1;
+			EPixelFormat Format = PF_DepthStencil;
+			ETextureCreateFlags TargetableTextureFlags = TexCreate_DepthStencilTargetable | TexCreate_Memoryless;
+			ERHIAccess Access = ERHIAccess::DSVWrite;
+			FClearValueBinding ClearValue(0.f, 0);
 #if UE_VERSION_OLDER_THAN(5, 1, 0)
-		FRHIResourceCreateInfo CreateInfo(*DSName);
-		CreateInfo.ClearValueBinding = ClearValue;
-		DepthStencilTarget = RHICreateTexture2D(Width, Height, Format, NumMips, SampleCount, TargetableTextureFlags, Access, CreateInfo);
+			FRHIResourceCreateInfo CreateInfo(*DSName);
+			CreateInfo.ClearValueBinding = ClearValue;
+			DepthStencilTarget = RHICreateTexture2D(Width, Height, Format, NumMips, SampleCount, TargetableTextureFlags, Access, CreateInfo);
 #else
-		auto DepthStencilTargetDesc = FRHITextureCreateDesc::Create2D(*DSName)
-			.SetExtent(Width, Height)
-			.SetFormat(Format)
-			.SetNumMips(NumMips)
-			.SetNumSamples(SampleCount)
-			.SetFlags(TargetableTextureFlags)
-			.SetInitialState(Access)
-			.SetClearValue(ClearValue);
-		DepthStencilTarget = RHICreateTexture(DepthStencilTargetDesc);
+			auto DepthStencilTargetDesc = FRHITextureCreateDesc::Create2D(*DSName)
+				.SetExtent(Width, Height)
+				.SetFormat(Format)
+				.SetNumMips(NumMips)
+				.SetNumSamples(SampleCount)
+				.SetFlags(TargetableTextureFlags)
+				.SetInitialState(Access)
+				.SetClearValue(ClearValue);
+			DepthStencilTarget = RHICreateTexture(DepthStencilTargetDesc);
 #endif
-		NOESIS_BIND_DEBUG_TEXTURE_LABEL(FRHICommandListExecutor::GetImmediateCommandList(), DepthStencilTarget, *DSName);
+			NOESIS_BIND_DEBUG_TEXTURE_LABEL(FRHICommandListExecutor::GetImmediateCommandList(), DepthStencilTarget, *DSName);
+		}
 	}
 
-	return ::CreateRenderTarget(*Name, Width, Height, SampleCount, DepthStencilTarget, IsLinearColor);
+	return ::CreateRenderTarget(*Name, Width, Height, SampleCount, DepthStencilTarget, DepthStencilTargetKey, IsLinearColor, RenderTargetPool);
 }
 
 Noesis::Ptr<Noesis::RenderTarget> FNoesisRenderDevice::CloneRenderTarget(const char* Label, Noesis::RenderTarget* InSharedRenderTarget)
@@ -1194,7 +1417,7 @@ Noesis::Ptr<Noesis::RenderTarget> FNoesisRenderDevice::CloneRenderTarget(const c
 	uint32 SampleCount = ColorTarget->GetNumSamples();
 	FRHITexture* DepthStencilTarget = SharedRenderTarget->GetDepthStencilTarget();
 
-	return ::CreateRenderTarget(*Name, Width, Height, SampleCount, DepthStencilTarget, IsLinearColor);
+	return ::CreateRenderTarget(*Name, Width, Height, SampleCount, DepthStencilTarget, 0, IsLinearColor, RenderTargetPool);
 }
 
 Noesis::Ptr<Noesis::Texture> FNoesisRenderDevice::CreateTexture(const char* Label, uint32 Width, uint32 Height, uint32 NumLevels, Noesis::TextureFormat::Enum TextureFormat, const void** Data)
@@ -1269,6 +1492,8 @@ static void SetStaticUniformBuffer(FRHICommandList* RHICmdList, FRHIUniformBuffe
 
 void FNoesisRenderDevice::BeginOffscreenRender()
 {
+	InvalidateBoundPipelineState();
+
 	if (SceneTexturesUniformBuffer)
 	{
 		SetStaticUniformBuffer(RHICmdList, SceneTexturesUniformBuffer);
@@ -1291,6 +1516,8 @@ void FNoesisRenderDevice::EndOffscreenRender()
 
 void FNoesisRenderDevice::BeginOnscreenRender()
 {
+	InvalidateBoundPipelineState();
+
 	if (SceneTexturesUniformBuffer)
 	{
 		SetStaticUniformBuffer(RHICmdList, SceneTexturesUniformBuffer);
@@ -1341,6 +1568,7 @@ void FNoesisRenderDevice::SetRenderTarget(Noesis::RenderTarget* Surface)
 
 	check(RHICmdList->IsOutsideRenderPass());
 	RenderTarget->SetRenderTarget(RHICmdList);
+	InvalidateBoundPipelineState();
 
 	FRHITexture* ColorTarget = RenderTarget->GetColorTarget();
 	auto ColorTargetSize = ColorTarget->GetSizeXY();
@@ -1370,6 +1598,7 @@ void FNoesisRenderDevice::ResolveRenderTarget(Noesis::RenderTarget* Surface, con
 		SCOPED_DRAW_EVENT(*RHICmdList, Resolve);
 		FNoesisRenderTarget* RenderTarget = (FNoesisRenderTarget*)Surface;
 		RenderTarget->ResolveRenderTarget(RHICmdList, Tiles, NumTiles);
+		InvalidateBoundPipelineState();
 	}
 
 #if UE_VERSION_OLDER_THAN(5, 5, 0)
@@ -1388,12 +1617,26 @@ void FNoesisRenderDevice::ResolveRenderTarget(Noesis::RenderTarget* Surface, con
 
 void* FNoesisRenderDevice::MapVertices(uint32 Bytes)
 {
+	INC_DWORD_STAT(STAT_NoesisDynamicBufferLocks);
+	INC_DWORD_STAT_BY(STAT_NoesisDynamicBufferBytes, Bytes);
 #if UE_VERSION_OLDER_THAN(5, 0, 0)
 	void* Result = RHILockVertexBuffer(DynamicVertexBuffer, 0, Bytes, RLM_WriteOnly);
 #elif UE_VERSION_OLDER_THAN(5, 3, 0)
 	void* Result = RHILockBuffer(DynamicVertexBuffer, 0, Bytes, RLM_WriteOnly);
 #else
-	void* Result = RHICmdList->LockBuffer(DynamicVertexBuffer, 0, Bytes, RLM_WriteOnly);
+	EResourceLockMode LockMode = RLM_WriteOnly;
+	VertexBufferOffset = 0;
+	if (VertexBufferRing.IsEnabled())
+	{
+		bool Discard;
+		VertexBufferOffset = VertexBufferRing.Allocate(Bytes, Discard);
+		LockMode = Discard ? RLM_WriteOnly : RLM_WriteOnly_NoOverwrite;
+	}
+	if (LockMode == RLM_WriteOnly)
+	{
+		INC_DWORD_STAT(STAT_NoesisDynamicBufferDiscards);
+	}
+	void* Result = RHICmdList->LockBuffer(DynamicVertexBuffer, VertexBufferOffset, Bytes, LockMode);
 #endif
 	return Result;
 }
@@ -1411,12 +1654,26 @@ void FNoesisRenderDevice::UnmapVertices()
 
 void* FNoesisRenderDevice::MapIndices(uint32 Bytes)
 {
+	INC_DWORD_STAT(STAT_NoesisDynamicBufferLocks);
+	INC_DWORD_STAT_BY(STAT_NoesisDynamicBufferBytes, Bytes);
 #if UE_VERSION_OLDER_THAN(5, 0, 0)
 	void* Result = RHILockIndexBuffer(DynamicIndexBuffer, 0, Bytes, RLM_WriteOnly);
 #elif UE_VERSION_OLDER_THAN(5, 3, 0)
 	void* Result = RHILockBuffer(DynamicIndexBuffer, 0, Bytes, RLM_WriteOnly);
 #else
-	void* Result = RHICmdList->LockBuffer(DynamicIndexBuffer, 0, Bytes, RLM_WriteOnly);
+	EResourceLockMode LockMode = RLM_WriteOnly;
+	IndexBufferOffset = 0;
+	if (IndexBufferRing.IsEnabled())
+	{
+		bool Discard;
+		IndexBufferOffset = IndexBufferRing.Allocate(Bytes, Discard);
+		LockMode = Discard ? RLM_WriteOnly : RLM_WriteOnly_NoOverwrite;
+	}
+	if (LockMode == RLM_WriteOnly)
+	{
+		INC_DWORD_STAT(STAT_NoesisDynamicBufferDiscards);
+	}
+	void* Result = RHICmdList->LockBuffer(DynamicIndexBuffer, IndexBufferOffset, Bytes, LockMode);
 #endif
 	return Result;
 }
@@ -1627,12 +1884,15 @@ static inline void UpdateUniformBuffer(FRHICommandList* RHICmdList, FUniformBuff
 
 #if PLATFORM_APPLE
 	// UniformBuffers on Metal are broken. They are all treated as Volatile, and new data is not pushed to the GPU after an update.
+	// Single frame buffers are sub-allocated by the RHI from its per-frame memory instead of getting their own allocation.
+	INC_DWORD_STAT(STAT_NoesisUniformBufferCreations);
 #if UE_VERSION_OLDER_THAN(5, 0, 0)
-	UniformBuffer = RHICreateUniformBuffer(UniformBufferData, UniformBufferLayout, UniformBuffer_MultiFrame, EUniformBufferValidation::ValidateResources);
+	UniformBuffer = RHICreateUniformBuffer(UniformBufferData, UniformBufferLayout, UniformBuffer_SingleFrame, EUniformBufferValidation::ValidateResources);
 #else
-	UniformBuffer = RHICreateUniformBuffer(UniformBufferData, &UniformBufferLayout, UniformBuffer_MultiFrame, EUniformBufferValidation::ValidateResources);
+	UniformBuffer = RHICreateUniformBuffer(UniformBufferData, &UniformBufferLayout, UniformBuffer_SingleFrame, EUniformBufferValidation::ValidateResources);
 #endif
 #else
+	INC_DWORD_STAT(STAT_NoesisUniformBufferUpdates);
 #if UE_VERSION_OLDER_THAN(5, 3, 0)
 	RHIUpdateUniformBuffer(UniformBuffer, UniformBufferData);
 #else
@@ -1641,35 +1901,157 @@ static inline void UpdateUniformBuffer(FRHICommandList* RHICmdList, FUniformBuff
 #endif
 }
 
-static inline bool ConditionalUpdateUniformBuffer(FRHICommandList* RHICmdList, FUniformBufferRHIRef& UniformBuffer, uint32& BufferHash, const Noesis::UniformData& UniformData)
+void FNoesisRenderDevice::BeginUniformBufferFrame()
+{
+#if PLATFORM_APPLE
+	if (FrameUniformBuffersFrame != GFrameCounterRenderThread)
+	{
+		// Single frame uniform buffers can't be used after the frame they were created in.
+		FrameUniformBuffersFrame = GFrameCounterRenderThread;
+		FrameUniformBuffers.Reset();
+		VSConstantsHash = 0;
+		TextureSizeHash = 0;
+		PSRgbaConstantsHash = 0;
+		PSOpacityConstantsHash = 0;
+		PSRadialGradConstantsHash = 0;
+		BlurConstantsHash = 0;
+		ShadowConstantsHash = 0;
+	}
+#endif
+}
+
+bool FNoesisRenderDevice::ConditionalUpdateUniformBuffer(FUniformBufferRHIRef& UniformBuffer, uint32& BufferHash, const Noesis::UniformData& UniformData)
 {
 	if (!BufferNeedsUpdate(BufferHash, UniformData))
 		return false;
 
 	uint32 UniformDataSize = UniformData.numDwords * 4;
 	const void* UniformDataValues = UniformData.values;
+#if PLATFORM_APPLE
+	// Values that alternate between batches, like the parameters of several gradients, reuse the buffer created for them earlier in the frame.
+	const uint64 Key = ((uint64)PointerHash(&UniformBuffer->GetLayout()) << 32) | UniformData.hash;
+	if (FUniformBufferRHIRef* FrameUniformBuffer = FrameUniformBuffers.Find(Key))
+	{
+		INC_DWORD_STAT(STAT_NoesisUniformBufferReuses);
+		UniformBuffer = *FrameUniformBuffer;
+	}
+	else
+	{
+		UpdateUniformBuffer(RHICmdList, UniformBuffer, UniformDataSize, UniformDataValues);
+		FrameUniformBuffers.Add(Key, UniformBuffer);
+	}
+#else
 	UpdateUniformBuffer(RHICmdList, UniformBuffer, UniformDataSize, UniformDataValues);
+#endif
 
 	BufferHash = UniformData.hash;
 
 	return true;
 }
 
-void FNoesisRenderDevice::DrawBatch(const Noesis::Batch& Batch)
+static uint32 GetPipelineStateKey(const Noesis::Batch& Batch, ERHIFeatureLevel::Type FeatureLevel, bool GammaCorrection, bool PatternLinear, bool PatternIgnoreAlpha,
+	bool AlphaMask, bool IsWorldUI, bool UsingGlobalPixelShader)
 {
-	check(RHICmdList);
-	FGraphicsPipelineStateInitializer GraphicsPSOInit;
-	RHICmdList->ApplyCachedRenderTargets(GraphicsPSOInit);
+	static_assert(Noesis::Shader::Count <= 256, "Shader code doesn't fit in the pipeline state key");
+	static_assert(ERHIFeatureLevel::Num <= 16, "Feature level doesn't fit in the pipeline state key");
+
+	uint32 Key = (uint32)Batch.shader.v;
+	Key |= (uint32)Batch.renderState.v << 8;
+	Key |= (uint32)Batch.singlePassStereo << 16;
+	Key |= (uint32)GammaCorrection << 17;
+	Key |= (uint32)PatternLinear << 18;
+	Key |= (uint32)PatternIgnoreAlpha << 19;
+	Key |= (uint32)AlphaMask << 20;
+	Key |= (uint32)IsWorldUI << 21;
+	Key |= (uint32)UsingGlobalPixelShader << 22;
+	Key |= (uint32)FeatureLevel << 24;
+	return Key;
+}
 
-	GraphicsPSOInit.DepthStencilState = GetDepthStencilState(Batch.renderState.f.stencilMode, AlphaMask);
+FNoesisPipelineState FNoesisRenderDevice::CreatePipelineState(const Noesis::Batch& Batch, ERHIFeatureLevel::Type FeatureLevel, bool GammaCorrection, bool PatternLinear, bool PatternIgnoreAlpha, bool UsingGlobalPixelShader) const
+{
+	FNoesisPipelineState PipelineState;
 
-	GraphicsPSOInit.BlendState = AlphaMask ? TStaticBlendState<CW_RGBA>::GetRHI() : (Batch.renderState.f.colorEnable ? (IsWorldUI ? GetBlendStateWorldUI(Batch.renderState.f.blendMode) : GetBlendState(Batch.renderState.f.blendMode)) : TStaticBlendState<CW_NONE>::GetRHI());
+	PipelineState.DepthStencilState = GetDepthStencilState(Batch.renderState.f.stencilMode, AlphaMask);
 
-	GraphicsPSOInit.RasterizerState = Batch.renderState.f.wireframe ? TStaticRasterizerState<FM_Wireframe, CM_None>::GetRHI() : TStaticRasterizerState<FM_Solid, CM_None>::GetRHI();
+	PipelineState.BlendState = AlphaMask ? TStaticBlendState<CW_RGBA>::GetRHI() : (Batch.renderState.f.colorEnable ? (IsWorldUI ? GetBlendStateWorldUI(Batch.renderState.f.blendMode) : GetBlendState(Batch.renderState.f.blendMode)) : TStaticBlendState<CW_NONE>::GetRHI());
+
+	PipelineState.RasterizerState = Batch.renderState.f.wireframe ? TStaticRasterizerState<FM_Wireframe, CM_None>::GetRHI() : TStaticRasterizerState<FM_Solid, CM_None>::GetRHI();
 
-	const ERHIFeatureLevel::Type FeatureLevel = Scene ? Scene->GetFeatureLevel() : GMaxRHIFeatureLevel;
 	FGlobalShaderMap* GlobalShaderMap = GetGlobalShaderMap(FeatureLevel);
 
+	Noesis::Shader::Enum ShaderCode = (Noesis::Shader::Enum)Batch.shader.v;
+	const uint8_t VertexShaderCode = Noesis::VertexForShader[ShaderCode];
+
+	FNoesisVS::FPermutationDomain VSPermutation;
+	VSPermutation.Set<FNoesisVS::FVertexShader>(VertexShaderCode);
+	VSPermutation.Set<FNoesisVS::FStereo>(Batch.singlePassStereo);
+	VSPermutation.Set<FNoesisVS::FLinearColor>(IsLinearColor);
+
+	PipelineState.VertexShader = GlobalShaderMap->GetShader<FNoesisVS>(VSPermutation);
+
+	PipelineState.VertexDeclaration = GetVertexDelcaration((Noesis::Shader::Vertex::Format::Enum)Noesis::FormatForVertex[VertexShaderCode]);
+
+	if (UsingGlobalPixelShader)
+	{
+		FNoesisPS::FPermutationDomain Permutation;
+		Permutation.Set<FNoesisPS::FEffect>(ShaderCode);
+		if (AlphaMask)
+		{
+			Permutation.Set<FNoesisPS::FLinearColor>(IsLinearColor);
+			Permutation.Set<FNoesisPS::FAlphaMask>(AlphaMask);
+		}
+		else
+		{
+			Permutation.Set<FNoesisPS::FGammaCorrection>(GammaCorrection);
+			if (NoesisShaderHasPattern[ShaderCode])
+			{
+				Permutation.Set<FNoesisPS::FPatternIgnoreAlpha>(PatternIgnoreAlpha);
+				// The combinations where IsLinearColor == PatternLinear are the same. We only build the (false, false) shader permutation.
+				Permutation.Set<FNoesisPS::FPatternLinear>(!IsLinearColor && PatternLinear);
+				Permutation.Set<FNoesisPS::FLinearColor>(IsLinearColor && !PatternLinear);
+			}
+		}
+		PipelineState.PixelShader = GlobalShaderMap->GetShader<FNoesisPS>(Permutation);
+	}
+
+	return PipelineState;
+}
+
+const FNoesisPipelineState* FNoesisRenderDevice::FindPipelineState(uint32 Key)
+{
+	if (!CachePipelineStates)
+		return nullptr;
+
+#if WITH_EDITOR
+	// Global shaders can be recompiled in the editor, so we only keep the resolved shaders for one frame.
+	if (PipelineStateCacheFrame != GFrameCounterRenderThread)
+	{
+		PipelineStateCache.Reset();
+		PipelineStateCacheFrame = GFrameCounterRenderThread;
+	}
+#endif
+
+	const FNoesisPipelineState* PipelineState = PipelineStateCache.Find(Key);
+	if (PipelineState != nullptr)
+	{
+		INC_DWORD_STAT(STAT_NoesisPipelineStateCacheHits);
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_NoesisPipelineStateCacheMisses);
+	}
+
+	return PipelineState;
+}
+
+void FNoesisRenderDevice::DrawBatch(const Noesis::Batch& Batch)
+{
+	check(RHICmdList);
+	BeginUniformBufferFrame();
+
+	const ERHIFeatureLevel::Type FeatureLevel = Scene ? Scene->GetFeatureLevel() : GMaxRHIFeatureLevel;
+
 	Noesis::Shader::Enum ShaderCode = (Noesis::Shader::Enum)Batch.shader.v;
 
 	bool GammaCorrection = !FMath::IsNearlyEqual(Gamma, 2.2f) || !FMath::IsNearlyEqual(Contrast, 1.0f);
@@ -1744,49 +2126,25 @@ void FNoesisRenderDevice::DrawBatch(const Noesis::Batch& Batch)
 		PatternIgnoreAlpha = Texture->MustIgnoreAlpha();
 	}
 
-	const uint8_t VertexShaderCode = Noesis::VertexForShader[ShaderCode];
-
-	FNoesisVS::FPermutationDomain VSPermutation;
-	VSPermutation.Set<FNoesisVS::FVertexShader>(VertexShaderCode);
-	VSPermutation.Set<FNoesisVS::FStereo>(Batch.singlePassStereo);
-	VSPermutation.Set<FNoesisVS::FLinearColor>(IsLinearColor);
-
-	TShaderRef<FNoesisVS> VertexShader = GlobalShaderMap->GetShader<FNoesisVS>(VSPermutation);
-
-	FVertexDeclarationRHIRef VertexDeclaration = GetVertexDelcaration((Noesis::Shader::Vertex::Format::Enum)Noesis::FormatForVertex[VertexShaderCode]);
-
-	TShaderRef<FNoesisPS> PixelShader;
-	if (!UsingCustomEffect && !UsingMaterialShader)
+	// Material pixel shaders are resolved for every batch, only the global ones are cached
+	const bool UsingGlobalPixelShader = !UsingCustomEffect && !UsingMaterialShader;
+	const uint32 PipelineStateKey = GetPipelineStateKey(Batch, FeatureLevel, GammaCorrection, PatternLinear, PatternIgnoreAlpha, AlphaMask, IsWorldUI, UsingGlobalPixelShader);
+	const FNoesisPipelineState* PipelineState = FindPipelineState(PipelineStateKey);
+	FNoesisPipelineState UncachedPipelineState;
+	if (PipelineState == nullptr)
 	{
-		FNoesisPS::FPermutationDomain Permutation;
-		Permutation.Set<FNoesisPS::FEffect>(ShaderCode);
-		if (AlphaMask)
-		{
-			Permutation.Set<FNoesisPS::FLinearColor>(IsLinearColor);
-			Permutation.Set<FNoesisPS::FAlphaMask>(AlphaMask);
-		}
-		else
-		{
-			Permutation.Set<FNoesisPS::FGammaCorrection>(GammaCorrection);
-			if (NoesisShaderHasPattern[ShaderCode])
-			{
-				Permutation.Set<FNoesisPS::FPatternIgnoreAlpha>(PatternIgnoreAlpha);
-				// The combinations where IsLinearColor == PatternLinear are the same. We only build the (false, false) shader permutation.
-				Permutation.Set<FNoesisPS::FPatternLinear>(!IsLinearColor && PatternLinear);
-				Permutation.Set<FNoesisPS::FLinearColor>(IsLinearColor && !PatternLinear);
-			}
-		}
-		PixelShader = GlobalShaderMap->GetShader<FNoesisPS>(Permutation);
+		UncachedPipelineState = CreatePipelineState(Batch, FeatureLevel, GammaCorrection, PatternLinear, PatternIgnoreAlpha, UsingGlobalPixelShader);
+		PipelineState = CachePipelineStates ? &PipelineStateCache.Add(PipelineStateKey, UncachedPipelineState) : &UncachedPipelineState;
 	}
 
+	const TShaderRef<FNoesisVS>& VertexShader = PipelineState->VertexShader;
+	const TShaderRef<FNoesisPS>& PixelShader = PipelineState->PixelShader;
+	FRHIPixelShader* PixelShaderRHI = UsingCustomEffect ? CustomEffectPixelShader.GetPixelShader() : (UsingMaterialShader ? MaterialPixelShader.GetPixelShader() : PixelShader.GetPixelShader());
+
 	FUniformBufferRHIRef& PSUniformBuffer0 = *PixelShaderConstantBuffer0[ShaderCode];
 	FUniformBufferRHIRef& PSUniformBuffer1 = *PixelShaderConstantBuffer1[ShaderCode];
 	uint32& PSUniformBuffer0Hash = *PixelShaderConstantBuffer0Hash[ShaderCode];
 	uint32& PSUniformBuffer1Hash = *PixelShaderConstantBuffer1Hash[ShaderCode];
-	GraphicsPSOInit.BoundShaderState.VertexDeclarationRHI = VertexDeclaration;
-	GraphicsPSOInit.BoundShaderState.VertexShaderRHI = VertexShader.GetVertexShader();
-	GraphicsPSOInit.BoundShaderState.PixelShaderRHI = UsingCustomEffect ? CustomEffectPixelShader.GetPixelShader() : (UsingMaterialShader ? MaterialPixelShader.GetPixelShader() : PixelShader.GetPixelShader());
-	GraphicsPSOInit.PrimitiveType = PT_TriangleList;
 
 	// This can happen when the shaders are being recompiled in the editor.
 	if (!VertexShader.IsValid())
@@ -1794,84 +2152,93 @@ void FNoesisRenderDevice::DrawBatch(const Noesis::Batch& Batch)
 
 	if (UsingCustomEffect)
 	{
-#if UE_VERSION_OLDER_THAN(5, 6, 0)
-#else
-#if PSO_PRECACHING_VALIDATE
-		if (PSOCollectorStats::IsFullPrecachingValidationEnabled())
-		{
-			static const int32 MaterialPSOCollectorIndex = FPSOCollectorCreateManager::GetIndex(GetFeatureLevelShadingPath(FeatureLevel), NoesisMaterialPSOCollectorName);
-			PSOCollectorStats::CheckFullPipelineStateInCache(GraphicsPSOInit, EPSOPrecacheResult::Unknown, MaterialProxy, nullptr, nullptr, MaterialPSOCollectorIndex);
-		}
-#endif // PSO_PRECACHING_VALIDATE
-#endif
-
 		if (!CustomEffectPixelShader.IsValid() || !ViewUniformBuffer.IsValid() || (!SceneTexturesUniformBuffer.IsValid() && !MobileSceneTexturesUniformBuffer.IsValid()) || (View == nullptr))
 			return;
 	}
 	else if (UsingMaterialShader)
 	{
-#if UE_VERSION_OLDER_THAN(5, 6, 0)
-#else
-#if PSO_PRECACHING_VALIDATE
-		if (PSOCollectorStats::IsFullPrecachingValidationEnabled())
-		{
-			static const int32 MaterialPSOCollectorIndex = FPSOCollectorCreateManager::GetIndex(GetFeatureLevelShadingPath(FeatureLevel), NoesisMaterialPSOCollectorName);
-			PSOCollectorStats::CheckFullPipelineStateInCache(GraphicsPSOInit, EPSOPrecacheResult::Unknown, MaterialProxy, nullptr, nullptr, MaterialPSOCollectorIndex);
-		}
-#endif // PSO_PRECACHING_VALIDATE
-#endif
-
 		if (!MaterialPixelShader.IsValid() || !ViewUniformBuffer.IsValid() || (View == nullptr))
 			return;
 	}
 	else
 	{
+		if (!PixelShader.IsValid())
+			return;
+	}
+
+	if (CachePipelineStates && PipelineStateBound && BoundPipelineStateKey == PipelineStateKey && BoundPixelShader == PixelShaderRHI)
+	{
+		INC_DWORD_STAT(STAT_NoesisPipelineStateChangesSkipped);
+	}
+	else
+	{
+		FGraphicsPipelineStateInitializer GraphicsPSOInit;
+		RHICmdList->ApplyCachedRenderTargets(GraphicsPSOInit);
+
+		GraphicsPSOInit.DepthStencilState = PipelineState->DepthStencilState;
+		GraphicsPSOInit.BlendState = PipelineState->BlendState;
+		GraphicsPSOInit.RasterizerState = PipelineState->RasterizerState;
+		GraphicsPSOInit.BoundShaderState.VertexDeclarationRHI = PipelineState->VertexDeclaration;
+		GraphicsPSOInit.BoundShaderState.VertexShaderRHI = VertexShader.GetVertexShader();
+		GraphicsPSOInit.BoundShaderState.PixelShaderRHI = PixelShaderRHI;
+		GraphicsPSOInit.PrimitiveType = PT_TriangleList;
+
 #if UE_VERSION_OLDER_THAN(5, 6, 0)
 #else
 #if PSO_PRECACHING_VALIDATE
 		if (PSOCollectorStats::IsFullPrecachingValidationEnabled())
 		{
-			static const int32 GlobalPSOCollectorIndex = FGlobalPSOCollectorManager::GetIndex(NoesisGlobalPSOCollectorName);
-			PSOCollectorStats::CheckGlobalGraphicsPipelineStateInCache(GraphicsPSOInit, GlobalPSOCollectorIndex);
+			if (UsingCustomEffect || UsingMaterialShader)
+			{
+				static const int32 MaterialPSOCollectorIndex = FPSOCollectorCreateManager::GetIndex(GetFeatureLevelShadingPath(FeatureLevel), NoesisMaterialPSOCollectorName);
+				PSOCollectorStats::CheckFullPipelineStateInCache(GraphicsPSOInit, EPSOPrecacheResult::Unknown, MaterialProxy, nullptr, nullptr, MaterialPSOCollectorIndex);
+			}
+			else
+			{
+				static const int32 GlobalPSOCollectorIndex = FGlobalPSOCollectorManager::GetIndex(NoesisGlobalPSOCollectorName);
+				PSOCollectorStats::CheckGlobalGraphicsPipelineStateInCache(GraphicsPSOInit, GlobalPSOCollectorIndex);
+			}
 		}
 #endif // PSO_PRECACHING_VALIDATE
 #endif
 
-		if (!PixelShader.IsValid())
-			return;
-	}
-
 #if UE_VERSION_OLDER_THAN(5, 0, 0)
-	SetGraphicsPipelineState(*RHICmdList, GraphicsPSOInit);
+		SetGraphicsPipelineState(*RHICmdList, GraphicsPSOInit);
 #else
-	SetGraphicsPipelineState(*RHICmdList, GraphicsPSOInit, Batch.stencilRef);
+		SetGraphicsPipelineState(*RHICmdList, GraphicsPSOInit, Batch.stencilRef);
 #endif
 
+		PipelineStateBound = true;
+		BoundPipelineStateKey = PipelineStateKey;
+		BoundPixelShader = PixelShaderRHI;
+		BoundMultiViewCount = GraphicsPSOInit.MultiViewCount;
+	}
+
 	uint32 NumInstances = 1;
 
 	// Update the uniform buffers
 	if (Batch.singlePassStereo)
 	{
 		//GraphicsPSOInit.MultiViewCount = 2;
-		if (GraphicsPSOInit.MultiViewCount == 0)
+		if (BoundMultiViewCount == 0)
 		{
 			NumInstances = 2;
 		}
 
-		ConditionalUpdateUniformBuffer(RHICmdList, VSConstantBufferStereo, VSConstantsHash, Batch.vertexUniforms[0]);
+		ConditionalUpdateUniformBuffer(VSConstantBufferStereo, VSConstantsHash, Batch.vertexUniforms[0]);
 		VertexShader->SetVSConstantsStereo(*RHICmdList, VSConstantBufferStereo);
 	}
 	else
 	{
-		ConditionalUpdateUniformBuffer(RHICmdList, VSConstantBuffer, VSConstantsHash, Batch.vertexUniforms[0]);
+		ConditionalUpdateUniformBuffer(VSConstantBuffer, VSConstantsHash, Batch.vertexUniforms[0]);
 		VertexShader->SetVSConstants(*RHICmdList, VSConstantBuffer);
 	}
 
-	ConditionalUpdateUniformBuffer(RHICmdList, TextureSizeBuffer, TextureSizeHash, Batch.vertexUniforms[1]);
+	ConditionalUpdateUniformBuffer(TextureSizeBuffer, TextureSizeHash, Batch.vertexUniforms[1]);
 
-	ConditionalUpdateUniformBuffer(RHICmdList, PSUniformBuffer0, PSUniformBuffer0Hash, Batch.pixelUniforms[0]);
+	ConditionalUpdateUniformBuffer(PSUniformBuffer0, PSUniformBuffer0Hash, Batch.pixelUniforms[0]);
 
-	ConditionalUpdateUniformBuffer(RHICmdList, PSUniformBuffer1, PSUniformBuffer1Hash, Batch.pixelUniforms[1]);
+	ConditionalUpdateUniformBuffer(PSUniformBuffer1, PSUniformBuffer1Hash, Batch.pixelUniforms[1]);
 
 	if (Batch.vertexUniforms[1].values != nullptr)
 	{
@@ -1907,9 +2274,9 @@ void FNoesisRenderDevice::DrawBatch(const Noesis::Batch& Batch)
 	}
 
 	RHICmdList->SetStencilRef(Batch.stencilRef);
-	RHICmdList->SetStreamSource(0, DynamicVertexBuffer, Batch.vertexOffset);
+	RHICmdList->SetStreamSource(0, DynamicVertexBuffer, VertexBufferOffset + Batch.vertexOffset);
 
-	RHICmdList->DrawIndexedPrimitive(DynamicIndexBuffer, 0, 0, Batch.numVertices, Batch.startIndex, Batch.numIndices / 3, NumInstances);
+	RHICmdList->DrawIndexedPrimitive(DynamicIndexBuffer, 0, 0, Batch.numVertices, IndexBufferOffset / sizeof(uint16) + Batch.startIndex, Batch.numIndices / 3, NumInstances);
 }
 
 #if UE_VERSION_OLDER_THAN(5, 6, 0)
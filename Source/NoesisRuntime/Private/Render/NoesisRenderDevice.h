@@ -46,6 +46,33 @@
 	#define NOESIS_BIND_DEBUG_BUFFER_LABEL(RHICmdList, Buffer, Name) NOESIS_BIND_DEBUG_LABEL(RHICmdList, Buffer, Name)
 #endif
 
+struct FNoesisPipelineState
+{
+	FRHIDepthStencilState* DepthStencilState = nullptr;
+	FRHIBlendState* BlendState = nullptr;
+	FRHIRasterizerState* RasterizerState = nullptr;
+	FRHIVertexDeclaration* VertexDeclaration = nullptr;
+	TShaderRef<FNoesisVS> VertexShader;
+	TShaderRef<FNoesisPS> PixelShader; // Only valid for batches that don't use a material
+};
+
+// Sub-allocates the dynamic geometry of several frames from a single buffer, so maps don't need to
+// discard the buffer. Data written during the last NumFramesInFlight frames is never overwritten.
+struct FNoesisDynamicBufferRing
+{
+	uint32 Size = 0;
+	uint32 NumFramesInFlight = 0;
+	uint64 Head = 0; // Bytes allocated since the last discard, including padding
+	uint64 Frame = 0;
+	TArray<uint64, TInlineAllocator<4>> FrameStarts; // Head at the start of each frame in flight, oldest first
+
+	void Init(uint32 InSize, uint32 InNumFramesInFlight);
+	bool IsEnabled() const { return NumFramesInFlight > 0; }
+
+	// Returns the offset of the allocation. OutDiscard is set when the buffer had to be discarded to fit it.
+	uint32 Allocate(uint32 Bytes, bool& OutDiscard);
+};
+
 class FNoesisRenderDevice : public Noesis::RenderDevice
 {
 #if UE_VERSION_OLDER_THAN(5, 0, 0)
@@ -55,6 +82,12 @@ class FNoesisRenderDevice : public Noesis::RenderDevice
 	FBufferRHIRef DynamicVertexBuffer;
 	FBufferRHIRef DynamicIndexBuffer;
 #endif
+	FNoesisDynamicBufferRing VertexBufferRing;
+	FNoesisDynamicBufferRing IndexBufferRing;
+	uint32 VertexBufferOffset = 0;
+	uint32 IndexBufferOffset = 0;
+	uint32 DynamicBuffersMemory = 0;
+	TSharedPtr<class FNoesisRenderTargetPool, ESPMode::ThreadSafe> RenderTargetPool;
 	FUniformBufferRHIRef VSConstantBuffer;
 	FUniformBufferRHIRef VSConstantBufferStereo;
 	FUniformBufferRHIRef TextureSizeBuffer;
@@ -70,6 +103,22 @@ class FNoesisRenderDevice : public Noesis::RenderDevice
 	uint32 PSRadialGradConstantsHash = 0;
 	uint32 BlurConstantsHash = 0;
 	uint32 ShadowConstantsHash = 0;
+#if PLATFORM_APPLE
+	// Uniform buffers created during the current frame, indexed by layout and contents hash
+	TMap<uint64, FUniformBufferRHIRef> FrameUniformBuffers;
+	uint64 FrameUniformBuffersFrame = 0;
+#endif
+
+	// Pipeline states resolved from the batch render state and shader permutation
+	bool CachePipelineStates = true;
+	TMap<uint32, FNoesisPipelineState> PipelineStateCache;
+	uint64 PipelineStateCacheFrame = 0;
+
+	// Pipeline state currently bound to RHICmdList, used to skip redundant changes between batches
+	bool PipelineStateBound = false;
+	uint32 BoundPipelineStateKey = 0;
+	FRHIPixelShader* BoundPixelShader = nullptr;
+	uint8 BoundMultiViewCount = 0;
 
 #if UE_VERSION_OLDER_THAN(5, 5, 0)
 #if WANTS_DRAW_MESH_EVENTS
@@ -84,6 +133,13 @@ class FNoesisRenderDevice : public Noesis::RenderDevice
 	FNoesisRenderDevice(bool LinearColor);
 	virtual ~FNoesisRenderDevice();
 
+	FNoesisPipelineState CreatePipelineState(const Noesis::Batch& Batch, ERHIFeatureLevel::Type FeatureLevel, bool GammaCorrection, bool PatternLinear, bool PatternIgnoreAlpha, bool UsingGlobalPixelShader) const;
+	const FNoesisPipelineState* FindPipelineState(uint32 Key);
+	void InvalidateBoundPipelineState() { PipelineStateBound = false; }
+
+	void BeginUniformBufferFrame();
+	bool ConditionalUpdateUniformBuffer(FUniformBufferRHIRef& UniformBuffer, uint32& BufferHash, const Noesis::UniformData& UniformData);
+
 public:
 	FGameTime WorldTime;
 	FRHICommandList* RHICmdList = nullptr;
@@ -46,5 +46,9 @@ private:
     Noesis::Ptr<Noesis::IValueConverter> mConverter;
     Noesis::Ptr<BaseComponent> mConverterParameter;
 
+    // Table name resolved from the last Id used
+    Noesis::String mTableIdSource;
+    FName mTableId;
+
     NS_DECLARE_REFLECTION(LocTableExtension, Noesis::MarkupExtension)
 };
@@ -26,6 +26,9 @@ NOESISRUNTIME_API void NoesisNotifyArrayPropertyChanged(class UObject* Object, F
 NOESISRUNTIME_API void NoesisNotifyMapPropertyChanged(UObject* Owner, FName MapPropertyName);
 //@}
 
+/// Raises the property changed notifications deferred by the DeferPropertyChangedNotifications setting
+NOESISRUNTIME_API void NoesisFlushPropertyChangedNotifications();
+
 /// Raises the *CanExecuteChanged* event for the Command stored in the specified property
 //@{
 NOESISRUNTIME_API void NoesisNotifyCanExecuteFunctionChanged(class UObject* Object, FName CommandName);